@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+
+// Block-sparse storage for the B operand (K x N) of pruned weights,
+// compressed by block column (BSC): only the non-zero
+// block_rows x block_cols blocks are kept, in ascending block-row order
+// per block column. Each stored block is already in the packed B layout
+// (row-major, stride block_cols) and zero padded at the matrix edges, so
+// the driver multiplies it straight from here.
+
+namespace atlas_memory {
+
+struct BlockSparseMatrix {
+  int rows = 0, cols = 0;             // dense K x N
+  int block_rows = 8, block_cols = 8; // <= BK; a multiple of NR
+  std::vector<int> col_ptr;   // block column c: [col_ptr[c], col_ptr[c + 1])
+  std::vector<int> row_idx;   // block row of each stored block
+  std::vector<float> values;  // stored blocks, back to back
+
+  int block_row_count() const { return (rows + block_rows - 1) / block_rows; }
+  int block_col_count() const { return (cols + block_cols - 1) / block_cols; }
+  int nnz_blocks() const { return int(row_idx.size()); }
+
+  // Fraction of blocks stored
+  double density() const {
+    double total = double(block_row_count()) * block_col_count();
+    return total > 0 ? nnz_blocks() / total : 0.0;
+  }
+
+  const float *block(int b) const {
+    return values.data() + std::size_t(b) * block_rows * block_cols;
+  }
+};
+
+} // namespace atlas_memory
@@ -6,6 +6,7 @@ namespace atlas_memory::config {
 constexpr std::size_t CACHE_LINE = 64;
 constexpr std::size_t SIMD_ALIGNMENT = 128;
 constexpr std::size_t PAGE_SIZE = 16 * 1024;
+constexpr std::size_t L2_BYTES = 12ull * 1024 * 1024;
 
 constexpr std::size_t DEFAULT_BM = 256;
 constexpr std::size_t DEFAULT_BN = 256;
@@ -14,6 +15,15 @@ constexpr std::size_t DEFAULT_BK = 256;
 constexpr std::size_t MR = 8;
 constexpr std::size_t NR = 8;
 
+// Smallest sub-problem a Strassen level may produce (below it the
+// conventional packed kernel is faster)
+constexpr std::size_t STRASSEN_CROSSOVER = 1024;
+constexpr int STRASSEN_MAX_LEVELS = 2;
+
+// Default memory budget of the out-of-core driver (resident C block plus
+// double-buffered A / B slabs of the mapped matrices)
+constexpr std::size_t OUT_OF_CORE_BYTES = 1ull << 30;
+
 constexpr std::size_t MAX_WORKSPACE_BYTES = 512ull * 1024 * 1024;
 
 } // namespace atlas_memory::config
@@ -0,0 +1,48 @@
+#pragma once
+
+// Geometry of a 2D convolution, lowered to GEMM without an im2col buffer:
+// the packing stage gathers input patches straight into the packed
+// panels. Patch matrix per layout:
+//
+//   NHWC: A = (batch * OH * OW) x (KH * KW * C), k = (kh * KW + kw) * C + c
+//         weights HWIO (K x OC), output NHWC (pixels x OC)
+//   NCHW: B = (C * KH * KW) x (OH * OW) per image, k = (c * KH + kh) * KW + kw
+//         weights OIHW (OC x K), output NCHW (OC x pixels per image)
+
+namespace atlas_memory {
+
+enum class ConvLayout { NCHW, NHWC };
+
+struct ConvShape {
+  int batch = 1;
+  int channels = 0, height = 0, width = 0; // input C x H x W
+  int out_channels = 0;
+  int kernel_h = 1, kernel_w = 1;
+  int stride_h = 1, stride_w = 1;
+  int pad_h = 0, pad_w = 0;
+  int dilation_h = 1, dilation_w = 1;
+  ConvLayout layout = ConvLayout::NHWC;
+
+  // 0 when the dilated kernel does not fit the padded input (or the
+  // stride is not positive)
+  int out_height() const {
+    return out_extent(height, pad_h, kernel_h, stride_h, dilation_h);
+  }
+  int out_width() const {
+    return out_extent(width, pad_w, kernel_w, stride_w, dilation_w);
+  }
+
+  // Reduction length of the patch matrix
+  int patch_size() const { return kernel_h * kernel_w * channels; }
+
+private:
+  static int out_extent(int in, int pad, int kernel, int stride,
+                        int dilation) {
+    const int span = dilation * (kernel - 1) + 1;
+    if (stride <= 0 || in + 2 * pad < span)
+      return 0;
+    return (in + 2 * pad - span) / stride + 1;
+  }
+};
+
+} // namespace atlas_memory
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// 16-bit storage formats. Values are widened to fp32 when packed and
+// narrowed (round to nearest even) when stored; all arithmetic is fp32.
+// The conversions are plain C++ so they work on any host; AArch64 builds
+// use the native half-precision conversion instructions.
+
+namespace atlas_memory {
+
+struct bf16_t {
+  std::uint16_t bits;
+};
+
+struct fp16_t {
+  std::uint16_t bits;
+};
+
+inline std::uint32_t float_bits(float f) {
+  std::uint32_t x;
+  std::memcpy(&x, &f, sizeof x);
+  return x;
+}
+
+inline float bits_float(std::uint32_t x) {
+  float f;
+  std::memcpy(&f, &x, sizeof f);
+  return f;
+}
+
+// ================================================================
+// bfloat16: upper half of an IEEE binary32
+// ================================================================
+inline float to_float(bf16_t h) {
+  return bits_float(std::uint32_t(h.bits) << 16);
+}
+
+inline bf16_t bf16_from_float(float f) {
+  std::uint32_t x = float_bits(f);
+
+  // Keep NaNs quiet (rounding could carry them into Inf)
+  if ((x & 0x7FFFFFFFu) > 0x7F800000u)
+    return bf16_t{std::uint16_t((x >> 16) | 0x0040u)};
+
+  x += 0x7FFFu + ((x >> 16) & 1u);
+  return bf16_t{std::uint16_t(x >> 16)};
+}
+
+// ================================================================
+// IEEE binary16
+// ================================================================
+inline float to_float(fp16_t h) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+  __fp16 v;
+  std::memcpy(&v, &h.bits, sizeof v);
+  return float(v);
+#else
+  std::uint32_t sign = std::uint32_t(h.bits & 0x8000u) << 16;
+  std::uint32_t exp = (h.bits >> 10) & 0x1Fu;
+  std::uint32_t mant = h.bits & 0x3FFu;
+
+  if (exp == 0) {
+    // Zero / subnormal: mant * 2^-24 is exact in fp32
+    float v = float(mant) * 5.9604644775390625e-8f;
+    return bits_float(float_bits(v) | sign);
+  }
+
+  if (exp == 0x1F)
+    return bits_float(sign | 0x7F800000u | (mant << 13));
+
+  return bits_float(sign | ((exp + 112) << 23) | (mant << 13));
+#endif
+}
+
+inline fp16_t fp16_from_float(float f) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+  __fp16 v = f;
+  fp16_t h;
+  std::memcpy(&h.bits, &v, sizeof v);
+  return h;
+#else
+  std::uint32_t x = float_bits(f);
+  std::uint16_t sign = std::uint16_t((x >> 16) & 0x8000u);
+  std::uint32_t ax = x & 0x7FFFFFFFu;
+
+  // Inf / NaN
+  if (ax >= 0x7F800000u)
+    return fp16_t{std::uint16_t(sign | (ax > 0x7F800000u ? 0x7E00u : 0x7C00u))};
+
+  // >= 65520 rounds to Inf
+  if (ax >= 0x477FF000u)
+    return fp16_t{std::uint16_t(sign | 0x7C00u)};
+
+  // Below 2^-14: subnormal, round |f| / 2^-24 to nearest even integer
+  if (ax < 0x38800000u) {
+    float scaled = bits_float(ax) * 16777216.0f;
+    std::uint32_t m = std::uint32_t(scaled);
+    float rem = scaled - float(m);
+    if (rem > 0.5f || (rem == 0.5f && (m & 1u)))
+      ++m;
+    return fp16_t{std::uint16_t(sign | m)};
+  }
+
+  // Normal: re-bias the exponent and round to nearest even
+  ax += 0xC8000FFFu + ((ax >> 13) & 1u);
+  return fp16_t{std::uint16_t(sign | (ax >> 13))};
+#endif
+}
+
+// Overloaded narrowing used by templated stores
+inline void convert(float &dst, float v) { dst = v; }
+inline void convert(bf16_t &dst, float v) { dst = bf16_from_float(v); }
+inline void convert(fp16_t &dst, float v) { dst = fp16_from_float(v); }
+inline void convert(double &dst, double v) { dst = v; }
+
+inline float to_float(float v) { return v; }
+
+} // namespace atlas_memory
@@ -12,10 +12,13 @@ struct Layout {
   Region a;
   Region b;
   Region accum;
+  Region scratch;
   std::size_t total_bytes;
 };
 
 Layout compute_layout(std::size_t BM, std::size_t BN, std::size_t BK,
-                      std::size_t MR, std::size_t NR);
+                      std::size_t MR, std::size_t NR,
+                      std::size_t scratch_bytes = 0,
+                      std::size_t elem_bytes = sizeof(float));
 
 } // namespace atlas_memory
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+
+namespace atlas_memory {
+
+enum class MapMode {
+  Read,      // existing file, read-only
+  ReadWrite, // existing file, shared writable mapping
+  Create,    // file created / resized to rows x cols, writable
+};
+
+// Row-major fp32 matrix backed by a file mapping (ld = cols). Pages are
+// faulted in from disk on first touch and written back by the kernel, so
+// the matrix may exceed RAM. valid() is false when the file could not be
+// opened, sized or mapped.
+class MappedMatrix {
+public:
+  MappedMatrix(const char *path, std::size_t rows, std::size_t cols,
+               MapMode mode);
+
+  ~MappedMatrix();
+
+  MappedMatrix(const MappedMatrix &) = delete;
+  MappedMatrix &operator=(const MappedMatrix &) = delete;
+
+  bool valid() const noexcept { return data_ != nullptr; }
+
+  float *data() noexcept { return data_; }
+  const float *data() const noexcept { return data_; }
+
+  std::size_t rows() const noexcept { return rows_; }
+  std::size_t cols() const noexcept { return cols_; }
+  std::size_t ld() const noexcept { return cols_; }
+  std::size_t bytes() const noexcept { return rows_ * cols_ * sizeof(float); }
+
+private:
+  float *data_{nullptr};
+  std::size_t rows_{0};
+  std::size_t cols_{0};
+  int fd_{-1};
+};
+
+// Paging hints on [addr, addr + bytes) of a shared file mapping. Read-ahead
+// and writeback widen the range to whole pages; dropping residency only
+// covers the pages entirely inside it (neighbouring data stays resident).
+// Never call advise_dontneed on anonymous or private memory: the kernel
+// discards those pages instead of re-reading them.
+void advise_willneed(const void *addr, std::size_t bytes); // start reading
+void advise_dontneed(const void *addr, std::size_t bytes); // drop residency
+void flush_async(void *addr, std::size_t bytes);           // start writeback
+
+} // namespace atlas_memory
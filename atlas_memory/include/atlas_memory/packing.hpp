@@ -1,4 +1,11 @@
 #pragma once
+#include "block_sparse.hpp"
+#include "conv_shape.hpp"
+#include "half.hpp"
+#include "quant_weights.hpp"
+
+#include <complex>
+#include <cstdint>
 
 namespace atlas_memory {
 
@@ -6,4 +13,78 @@ void pack_A(float *dst, const float *src, int rows, int cols, int ld);
 
 void pack_B(float *dst, const float *src, int rows, int cols, int ld);
 
+// Linear combination sum_t coef[t] * src[t] of equally strided blocks,
+// formed while packing (fused Strassen operand additions)
+void pack_A(float *dst, const float *const *src, const float *coef,
+            int terms, int rows, int cols, int ld);
+void pack_B(float *dst, const float *const *src, const float *coef,
+            int terms, int rows, int cols, int ld);
+
+// B block read from its transpose: src is a row-major cols x rows matrix
+// (the A^T operand of SYRK / TRMM), dst gets the usual rows x cols layout
+void pack_B_transposed(float *dst, const float *src, int rows, int cols,
+                       int ld);
+
+// fp64 panels (DGEMM), same row-major layout
+void pack_A(double *dst, const double *src, int rows, int cols, int ld);
+void pack_B(double *dst, const double *src, int rows, int cols, int ld);
+
+// bf16 / fp16 sources, widened to fp32 while packing
+void pack_A(float *dst, const bf16_t *src, int rows, int cols, int ld);
+void pack_A(float *dst, const fp16_t *src, int rows, int cols, int ld);
+
+void pack_B(float *dst, const bf16_t *src, int rows, int cols, int ld);
+void pack_B(float *dst, const fp16_t *src, int rows, int cols, int ld);
+
+// Real component of an interleaved complex block, split out while packing
+// (3M / 4M complex GEMM on the real kernels)
+enum class ComplexPart : std::uint8_t {
+  Real,    // re(z)
+  Imag,    // im(z)
+  NegImag, // -im(z)
+  Sum,     // re(z) + im(z)
+};
+
+void pack_A(float *dst, const std::complex<float> *src, int rows, int cols,
+            int ld, ComplexPart part);
+void pack_A(double *dst, const std::complex<double> *src, int rows, int cols,
+            int ld, ComplexPart part);
+
+void pack_B(float *dst, const std::complex<float> *src, int rows, int cols,
+            int ld, ComplexPart part);
+void pack_B(double *dst, const std::complex<double> *src, int rows, int cols,
+            int ld, ComplexPart part);
+
+// Rows [k0, k0 + rows) and columns [j0, j0 + cols) of quantized weights,
+// dequantized into an fp32 B block (same layout as pack_B)
+void pack_B(float *dst, const QuantizedWeights &src, int k0, int j0,
+            int rows, int cols);
+
+// Block-sparse B from a dense row-major rows x cols matrix: every block
+// with a non-zero element is packed, all-zero blocks are dropped. Needs
+// 0 < block_rows <= DEFAULT_BK and block_cols a multiple of NR; other
+// geometries give an empty 0 x 0 matrix.
+BlockSparseMatrix pack_block_sparse(const float *src, int rows, int cols,
+                                    int ld, int block_rows, int block_cols);
+
+// Implicit im2col (see conv_shape.hpp): a block of the patch matrix
+// gathered from the input, zeros where a tap falls in the padding.
+// NHWC A block: pixels [p0, p0 + rows) of the batch x taps [k0, k0 + cols)
+void pack_A(float *dst, const float *input, const ConvShape &s, int p0,
+            int k0, int rows, int cols);
+// NCHW B block of one image: taps [k0, k0 + rows) x pixels [p0, p0 + cols)
+void pack_B(float *dst, const float *image, const ConvShape &s, int k0,
+            int p0, int rows, int cols);
+
+// int8 panels for the u8 x s8 kernels: MR-row (A) / NR-column (B) panels,
+// K in groups of 4 (k-group major, 4 consecutive k per row/column), zero
+// padded to full panels. A is stored re-biased to s8 (a - 128). Sums of
+// the source values over the packed K range are added to row_sums /
+// col_sums (rows / cols entries).
+void pack_A_u8(std::int8_t *dst, const std::uint8_t *src, int rows, int cols,
+               int ld, std::int32_t *row_sums);
+
+void pack_B_s8(std::int8_t *dst, const std::int8_t *src, int rows, int cols,
+               int ld, std::int32_t *col_sums);
+
 } // namespace atlas_memory
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+// Weight-only quantized storage for the B operand (K x N). Scales and zero
+// points are group-wise along K and per column:
+//
+//   w[k][j] = (q[k][j] - zero[g][j]) * scale[g][j],   g = k / group_size
+//
+// The packing stage dequantizes into the usual fp32 B panels, so only the
+// compressed bytes are streamed from memory.
+
+namespace atlas_memory {
+
+enum class WeightFormat : std::uint8_t {
+  Int8, // one s8 per element
+  Int4, // two u4 per byte, even column in the low nibble
+};
+
+struct QuantizedWeights {
+  WeightFormat format = WeightFormat::Int4;
+  const std::uint8_t *data = nullptr;
+  int ld = 0;                   // row stride in elements (even for Int4)
+  const float *scales = nullptr; // ceil(K / group_size) x ld_scales
+  const float *zeros = nullptr;  // same layout; nullptr: 0 (Int8), 8 (Int4)
+  int ld_scales = 0;
+  int group_size = 128;
+};
+
+inline int quantized_value(const QuantizedWeights &w, int k, int j) {
+  if (w.format == WeightFormat::Int8)
+    return std::int8_t(w.data[k * w.ld + j]);
+
+  std::uint8_t byte = w.data[(k * w.ld + j) / 2];
+  return (j & 1) ? byte >> 4 : byte & 0x0F;
+}
+
+inline float default_zero(WeightFormat f) {
+  return f == WeightFormat::Int4 ? 8.0f : 0.0f;
+}
+
+// Scalar reference of a single element
+inline float dequantize(const QuantizedWeights &w, int k, int j) {
+  int g = (k / w.group_size) * w.ld_scales + j;
+  float zero = w.zeros ? w.zeros[g] : default_zero(w.format);
+  return (float(quantized_value(w, k, j)) - zero) * w.scales[g];
+}
+
+} // namespace atlas_memory
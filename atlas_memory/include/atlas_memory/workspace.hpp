@@ -3,26 +3,37 @@
 
 namespace atlas_memory {
 
-class Workspace {
+// Packing / accumulator buffers for one thread, typed on the scalar of
+// the packed panels (float for SGEMM, double for DGEMM). Explicitly
+// instantiated for float and double in workspace.cpp.
+template <class T> class BasicWorkspace {
 public:
-  Workspace(std::size_t BM, std::size_t BN, std::size_t BK, std::size_t MR,
-            std::size_t NR);
+  BasicWorkspace(std::size_t BM, std::size_t BN, std::size_t BK,
+                 std::size_t MR, std::size_t NR,
+                 std::size_t scratch_bytes = 0);
 
-  ~Workspace();
+  ~BasicWorkspace();
 
-  Workspace(const Workspace &) = delete;
-  Workspace &operator=(const Workspace &) = delete;
+  BasicWorkspace(const BasicWorkspace &) = delete;
+  BasicWorkspace &operator=(const BasicWorkspace &) = delete;
 
-  float *packA() noexcept;
-  float *packB() noexcept;
-  float *accum() noexcept;
+  T *packA() noexcept;
+  T *packB() noexcept;
+  T *accum() noexcept;
+  T *scratch() noexcept;
 
   std::size_t packA_capacity() const noexcept;
   std::size_t packB_capacity() const noexcept;
   std::size_t accum_capacity() const noexcept;
+  std::size_t scratch_capacity() const noexcept;
 
   std::size_t total_capacity() const noexcept;
 
+  // Cache blocking the buffers were sized for
+  std::size_t block_m() const noexcept;
+  std::size_t block_n() const noexcept;
+  std::size_t block_k() const noexcept;
+
   void reset() noexcept;
 
 private:
@@ -38,10 +49,18 @@ private:
   std::size_t a_bytes_{0};
   std::size_t b_bytes_{0};
   std::size_t accum_bytes_{0};
+  std::size_t scratch_bytes_{0};
 
-  float *a_ptr_{nullptr};
-  float *b_ptr_{nullptr};
-  float *accum_ptr_{nullptr};
+  T *a_ptr_{nullptr};
+  T *b_ptr_{nullptr};
+  T *accum_ptr_{nullptr};
+  T *scratch_ptr_{nullptr};
 };
 
+using Workspace = BasicWorkspace<float>;
+using WorkspaceF64 = BasicWorkspace<double>;
+
+extern template class BasicWorkspace<float>;
+extern template class BasicWorkspace<double>;
+
 } // namespace atlas_memory
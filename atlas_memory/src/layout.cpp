@@ -9,23 +9,28 @@ static std::size_t align_up(std::size_t x, std::size_t align) {
 }
 
 Layout compute_layout(std::size_t BM, std::size_t BN, std::size_t BK,
-                      std::size_t MR, std::size_t NR) {
+                      std::size_t MR, std::size_t NR,
+                      std::size_t scratch_bytes, std::size_t elem_bytes) {
   Layout l{};
 
   std::size_t offset = 0;
 
   l.a.offset = align_up(offset, config::SIMD_ALIGNMENT);
-  l.a.bytes = BM * BK * sizeof(float);
+  l.a.bytes = BM * BK * elem_bytes;
   offset = l.a.offset + l.a.bytes;
 
   l.b.offset = align_up(offset, config::SIMD_ALIGNMENT);
-  l.b.bytes = BK * BN * sizeof(float);
+  l.b.bytes = BK * BN * elem_bytes;
   offset = l.b.offset + l.b.bytes;
 
   l.accum.offset = align_up(offset, config::SIMD_ALIGNMENT);
-  l.accum.bytes = MR * NR * sizeof(float);
+  l.accum.bytes = MR * NR * elem_bytes;
   offset = l.accum.offset + l.accum.bytes;
 
+  l.scratch.offset = align_up(offset, config::SIMD_ALIGNMENT);
+  l.scratch.bytes = scratch_bytes;
+  offset = l.scratch.offset + l.scratch.bytes;
+
   l.total_bytes = align_up(offset, config::SIMD_ALIGNMENT);
 
   assert(l.total_bytes < config::MAX_WORKSPACE_BYTES);
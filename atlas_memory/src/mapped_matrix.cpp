@@ -0,0 +1,93 @@
+#include "../include/atlas_memory/mapped_matrix.hpp"
+#include "../include/atlas_memory/config_m2.hpp"
+
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace atlas_memory {
+
+MappedMatrix::MappedMatrix(const char *path, std::size_t rows,
+                           std::size_t cols, MapMode mode)
+    : rows_(rows), cols_(cols) {
+  const bool write = mode != MapMode::Read;
+  const int flags =
+      mode == MapMode::Create ? O_RDWR | O_CREAT : write ? O_RDWR : O_RDONLY;
+
+  fd_ = open(path, flags, 0644);
+  if (fd_ < 0)
+    return;
+
+  const std::size_t size = bytes();
+
+  if (mode == MapMode::Create) {
+    if (ftruncate(fd_, off_t(size)) != 0)
+      return;
+  } else {
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || std::size_t(st.st_size) < size)
+      return;
+  }
+
+  if (size == 0)
+    return;
+
+  void *p = mmap(nullptr, size, write ? PROT_READ | PROT_WRITE : PROT_READ,
+                 MAP_SHARED, fd_, 0);
+  if (p != MAP_FAILED)
+    data_ = static_cast<float *>(p);
+}
+
+MappedMatrix::~MappedMatrix() {
+  if (data_)
+    munmap(data_, bytes());
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+// Page-aligned cover (outer) or interior (!outer) of [addr, addr + bytes).
+// config::PAGE_SIZE (16 KB) is a multiple of every supported base page
+// size.
+static bool page_range(const void *addr, std::size_t bytes, bool outer,
+                       void *&start, std::size_t &len) {
+  constexpr std::uintptr_t mask = config::PAGE_SIZE - 1;
+
+  if (!addr || bytes == 0)
+    return false;
+
+  auto a = reinterpret_cast<std::uintptr_t>(addr);
+  std::uintptr_t lo = outer ? a & ~mask : (a + mask) & ~mask;
+  std::uintptr_t hi = outer ? a + bytes : (a + bytes) & ~mask;
+
+  if (hi <= lo)
+    return false;
+
+  start = reinterpret_cast<void *>(lo);
+  len = hi - lo;
+  return true;
+}
+
+void advise_willneed(const void *addr, std::size_t bytes) {
+  void *start;
+  std::size_t len;
+  if (page_range(addr, bytes, true, start, len))
+    madvise(start, len, MADV_WILLNEED);
+}
+
+void advise_dontneed(const void *addr, std::size_t bytes) {
+  void *start;
+  std::size_t len;
+  if (page_range(addr, bytes, false, start, len))
+    madvise(start, len, MADV_DONTNEED);
+}
+
+void flush_async(void *addr, std::size_t bytes) {
+  void *start;
+  std::size_t len;
+  if (page_range(addr, bytes, true, start, len))
+    msync(start, len, MS_ASYNC);
+}
+
+} // namespace atlas_memory
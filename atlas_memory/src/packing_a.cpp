@@ -1,13 +1,56 @@
 #include "../include/atlas_memory/packing.hpp"
 namespace atlas_memory {
 
+template <class T>
+static void pack_A_copy(T *dst, const T *src, int rows, int cols, int ld) {
+  for (int i = 0; i < rows; ++i) {
+    const T *s = src + i * ld;
+    T *d = dst + i * cols;
+    for (int k = 0; k < cols; ++k)
+      d[k] = s[k];
+  }
+}
+
 void pack_A(float *dst, const float *src, int rows, int cols, int ld) {
+  pack_A_copy(dst, src, rows, cols, ld);
+}
+
+void pack_A(double *dst, const double *src, int rows, int cols, int ld) {
+  pack_A_copy(dst, src, rows, cols, ld);
+}
+
+void pack_A(float *dst, const float *const *src, const float *coef,
+            int terms, int rows, int cols, int ld) {
   for (int i = 0; i < rows; ++i) {
-    const float *s = src + i * ld;
     float *d = dst + i * cols;
     for (int k = 0; k < cols; ++k)
-      d[k] = s[k];
+      d[k] = coef[0] * src[0][i * ld + k];
+
+    for (int t = 1; t < terms; ++t) {
+      const float *s = src[t] + i * ld;
+      for (int k = 0; k < cols; ++k)
+        d[k] += coef[t] * s[k];
+    }
   }
 }
 
+template <class T>
+static void pack_A_widen(float *dst, const T *src, int rows, int cols,
+                         int ld) {
+  for (int i = 0; i < rows; ++i) {
+    const T *s = src + i * ld;
+    float *d = dst + i * cols;
+    for (int k = 0; k < cols; ++k)
+      d[k] = to_float(s[k]);
+  }
+}
+
+void pack_A(float *dst, const bf16_t *src, int rows, int cols, int ld) {
+  pack_A_widen(dst, src, rows, cols, ld);
+}
+
+void pack_A(float *dst, const fp16_t *src, int rows, int cols, int ld) {
+  pack_A_widen(dst, src, rows, cols, ld);
+}
+
 } // namespace atlas_memory
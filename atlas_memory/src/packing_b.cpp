@@ -1,7 +1,8 @@
 #include "../include/atlas_memory/packing.hpp"
 namespace atlas_memory {
 
-void pack_B(float *dst, const float *src, int rows, int cols, int ld) {
+template <class T>
+static void pack_B_copy(T *dst, const T *src, int rows, int cols, int ld) {
   for (int k = 0; k < rows; ++k) {
     for (int j = 0; j < cols; ++j) {
       dst[k * cols + j] = src[k * ld + j];
@@ -9,4 +10,55 @@ void pack_B(float *dst, const float *src, int rows, int cols, int ld) {
   }
 }
 
+void pack_B(float *dst, const float *src, int rows, int cols, int ld) {
+  pack_B_copy(dst, src, rows, cols, ld);
+}
+
+void pack_B(double *dst, const double *src, int rows, int cols, int ld) {
+  pack_B_copy(dst, src, rows, cols, ld);
+}
+
+void pack_B(float *dst, const float *const *src, const float *coef,
+            int terms, int rows, int cols, int ld) {
+  for (int k = 0; k < rows; ++k) {
+    float *d = dst + k * cols;
+    for (int j = 0; j < cols; ++j)
+      d[j] = coef[0] * src[0][k * ld + j];
+
+    for (int t = 1; t < terms; ++t) {
+      const float *s = src[t] + k * ld;
+      for (int j = 0; j < cols; ++j)
+        d[j] += coef[t] * s[j];
+    }
+  }
+}
+
+void pack_B_transposed(float *dst, const float *src, int rows, int cols,
+                       int ld) {
+  for (int j = 0; j < cols; ++j) {
+    const float *s = src + j * ld;
+    for (int k = 0; k < rows; ++k) {
+      dst[k * cols + j] = s[k];
+    }
+  }
+}
+
+template <class T>
+static void pack_B_widen(float *dst, const T *src, int rows, int cols,
+                         int ld) {
+  for (int k = 0; k < rows; ++k) {
+    for (int j = 0; j < cols; ++j) {
+      dst[k * cols + j] = to_float(src[k * ld + j]);
+    }
+  }
+}
+
+void pack_B(float *dst, const bf16_t *src, int rows, int cols, int ld) {
+  pack_B_widen(dst, src, rows, cols, ld);
+}
+
+void pack_B(float *dst, const fp16_t *src, int rows, int cols, int ld) {
+  pack_B_widen(dst, src, rows, cols, ld);
+}
+
 } // namespace atlas_memory
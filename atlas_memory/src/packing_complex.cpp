@@ -0,0 +1,59 @@
+#include "../include/atlas_memory/packing.hpp"
+namespace atlas_memory {
+
+// A and B blocks share the row-major layout, so one splitter serves both.
+// The part is resolved once per block, outside the copy loop.
+template <class T, class Part>
+static void pack_split(T *dst, const std::complex<T> *src, int rows, int cols,
+                       int ld, Part part) {
+  for (int i = 0; i < rows; ++i) {
+    const std::complex<T> *s = src + i * ld;
+    T *d = dst + i * cols;
+    for (int k = 0; k < cols; ++k)
+      d[k] = part(s[k]);
+  }
+}
+
+template <class T>
+static void pack_complex(T *dst, const std::complex<T> *src, int rows,
+                         int cols, int ld, ComplexPart part) {
+  using Z = std::complex<T>;
+
+  switch (part) {
+  case ComplexPart::Real:
+    pack_split(dst, src, rows, cols, ld, [](Z z) { return z.real(); });
+    break;
+  case ComplexPart::Imag:
+    pack_split(dst, src, rows, cols, ld, [](Z z) { return z.imag(); });
+    break;
+  case ComplexPart::NegImag:
+    pack_split(dst, src, rows, cols, ld, [](Z z) { return -z.imag(); });
+    break;
+  case ComplexPart::Sum:
+    pack_split(dst, src, rows, cols, ld,
+               [](Z z) { return z.real() + z.imag(); });
+    break;
+  }
+}
+
+void pack_A(float *dst, const std::complex<float> *src, int rows, int cols,
+            int ld, ComplexPart part) {
+  pack_complex(dst, src, rows, cols, ld, part);
+}
+
+void pack_A(double *dst, const std::complex<double> *src, int rows, int cols,
+            int ld, ComplexPart part) {
+  pack_complex(dst, src, rows, cols, ld, part);
+}
+
+void pack_B(float *dst, const std::complex<float> *src, int rows, int cols,
+            int ld, ComplexPart part) {
+  pack_complex(dst, src, rows, cols, ld, part);
+}
+
+void pack_B(double *dst, const std::complex<double> *src, int rows, int cols,
+            int ld, ComplexPart part) {
+  pack_complex(dst, src, rows, cols, ld, part);
+}
+
+} // namespace atlas_memory
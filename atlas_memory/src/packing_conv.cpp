@@ -0,0 +1,92 @@
+#include "../include/atlas_memory/packing.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace atlas_memory {
+
+// NHWC: consecutive taps of one kernel position are consecutive channels
+// of one input pixel, so a row of the block is a few contiguous copies
+// (one per kernel position, zero filled when it lands in the padding).
+void pack_A(float *dst, const float *input, const ConvShape &s, int p0,
+            int k0, int rows, int cols) {
+  const int OH = s.out_height(), OW = s.out_width();
+  const int C = s.channels;
+
+  for (int r = 0; r < rows; ++r) {
+    const int p = p0 + r;
+    const int n = p / (OH * OW), oh = (p / OW) % OH, ow = p % OW;
+    const float *img = input + std::size_t(n) * s.height * s.width * C;
+    float *out = dst + r * cols;
+
+    for (int k = k0; k < k0 + cols;) {
+      const int tap = k / C, c = k % C;
+      const int kh = tap / s.kernel_w, kw = tap % s.kernel_w;
+      const int run = std::min(C - c, k0 + cols - k);
+
+      const int ih = oh * s.stride_h - s.pad_h + kh * s.dilation_h;
+      const int iw = ow * s.stride_w - s.pad_w + kw * s.dilation_w;
+      float *o = out + (k - k0);
+
+      if (ih >= 0 && ih < s.height && iw >= 0 && iw < s.width) {
+        const float *src = img + (std::size_t(ih) * s.width + iw) * C + c;
+        std::copy(src, src + run, o);
+      } else {
+        std::fill(o, o + run, 0.0f);
+      }
+
+      k += run;
+    }
+  }
+}
+
+// NCHW: one tap over a run of pixels of the same output row reads one
+// input row with stride stride_w; only the ends of the run can fall in
+// the padding.
+void pack_B(float *dst, const float *image, const ConvShape &s, int k0,
+            int p0, int rows, int cols) {
+  const int OW = s.out_width();
+  const int KH = s.kernel_h, KW = s.kernel_w;
+
+  for (int r = 0; r < rows; ++r) {
+    const int k = k0 + r;
+    const int c = k / (KH * KW), kh = (k / KW) % KH, kw = k % KW;
+    const float *plane = image + std::size_t(c) * s.height * s.width;
+    float *out = dst + r * cols;
+
+    for (int j = 0; j < cols;) {
+      const int p = p0 + j;
+      const int oh = p / OW, ow = p % OW;
+      const int run = std::min(OW - ow, cols - j);
+
+      const int ih = oh * s.stride_h - s.pad_h + kh * s.dilation_h;
+      const int iw0 = ow * s.stride_w - s.pad_w + kw * s.dilation_w;
+      float *o = out + j;
+
+      if (ih < 0 || ih >= s.height) {
+        std::fill(o, o + run, 0.0f);
+        j += run;
+        continue;
+      }
+
+      int lo = 0, hi = run;
+      while (lo < run && iw0 + lo * s.stride_w < 0)
+        ++lo;
+      while (hi > lo && iw0 + (hi - 1) * s.stride_w >= s.width)
+        --hi;
+
+      const float *row = plane + std::size_t(ih) * s.width;
+      std::fill(o, o + lo, 0.0f);
+      if (s.stride_w == 1)
+        std::copy(row + iw0 + lo, row + iw0 + hi, o + lo);
+      else
+        for (int t = lo; t < hi; ++t)
+          o[t] = row[iw0 + t * s.stride_w];
+      std::fill(o + hi, o + run, 0.0f);
+
+      j += run;
+    }
+  }
+}
+
+} // namespace atlas_memory
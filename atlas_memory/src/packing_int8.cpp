@@ -0,0 +1,62 @@
+#include "../include/atlas_memory/config_m2.hpp"
+#include "../include/atlas_memory/packing.hpp"
+namespace atlas_memory {
+
+static constexpr int KGROUP = 4;
+
+void pack_A_u8(std::int8_t *dst, const std::uint8_t *src, int rows, int cols,
+               int ld, std::int32_t *row_sums) {
+  constexpr int MR = int(config::MR);
+  const int kp = (cols + KGROUP - 1) / KGROUP * KGROUP;
+
+  for (int p = 0; p < rows; p += MR) {
+    std::int8_t *panel = dst + (p / MR) * kp * MR;
+
+    for (int k = 0; k < kp; k += KGROUP) {
+      for (int r = 0; r < MR; ++r) {
+        for (int kk = 0; kk < KGROUP; ++kk) {
+          int i = p + r;
+          int kc = k + kk;
+
+          std::int8_t v = 0;
+          if (i < rows && kc < cols) {
+            std::uint8_t a = src[i * ld + kc];
+            v = std::int8_t(a ^ 0x80u);
+            row_sums[i] += a;
+          }
+
+          panel[k * MR + r * KGROUP + kk] = v;
+        }
+      }
+    }
+  }
+}
+
+void pack_B_s8(std::int8_t *dst, const std::int8_t *src, int rows, int cols,
+               int ld, std::int32_t *col_sums) {
+  constexpr int NR = int(config::NR);
+  const int kp = (rows + KGROUP - 1) / KGROUP * KGROUP;
+
+  for (int q = 0; q < cols; q += NR) {
+    std::int8_t *panel = dst + (q / NR) * kp * NR;
+
+    for (int k = 0; k < kp; k += KGROUP) {
+      for (int c = 0; c < NR; ++c) {
+        for (int kk = 0; kk < KGROUP; ++kk) {
+          int j = q + c;
+          int kr = k + kk;
+
+          std::int8_t v = 0;
+          if (j < cols && kr < rows) {
+            v = src[kr * ld + j];
+            col_sums[j] += v;
+          }
+
+          panel[k * NR + c * KGROUP + kk] = v;
+        }
+      }
+    }
+  }
+}
+
+} // namespace atlas_memory
@@ -0,0 +1,51 @@
+#include "../include/atlas_memory/packing.hpp"
+namespace atlas_memory {
+
+// Scales / zeros are constant over a group of K rows, so each row only
+// needs the two row pointers; the inner loops are plain element-wise
+// arithmetic the compiler vectorizes.
+void pack_B(float *dst, const QuantizedWeights &src, int k0, int j0,
+            int rows, int cols) {
+  const float zero = default_zero(src.format);
+
+  for (int k = 0; k < rows; ++k) {
+    const int g = (k0 + k) / src.group_size;
+    const float *scale = src.scales + g * src.ld_scales + j0;
+    const float *zp = src.zeros ? src.zeros + g * src.ld_scales + j0 : nullptr;
+    float *out = dst + k * cols;
+
+    if (src.format == WeightFormat::Int8) {
+      const std::int8_t *q =
+          reinterpret_cast<const std::int8_t *>(src.data) +
+          (k0 + k) * src.ld + j0;
+
+      for (int j = 0; j < cols; ++j)
+        out[j] = (float(q[j]) - (zp ? zp[j] : zero)) * scale[j];
+      continue;
+    }
+
+    // Int4: walk byte pairs; a leading odd column is decoded on its own
+    const int first = (k0 + k) * src.ld + j0;
+    int j = 0;
+
+    if (first & 1) {
+      out[0] = (float(src.data[first / 2] >> 4) - (zp ? zp[0] : zero)) *
+               scale[0];
+      j = 1;
+    }
+
+    const std::uint8_t *bytes = src.data + (first + j) / 2;
+
+    for (; j + 1 < cols; j += 2, ++bytes) {
+      float lo = float(*bytes & 0x0F);
+      float hi = float(*bytes >> 4);
+      out[j] = (lo - (zp ? zp[j] : zero)) * scale[j];
+      out[j + 1] = (hi - (zp ? zp[j + 1] : zero)) * scale[j + 1];
+    }
+
+    if (j < cols)
+      out[j] = (float(*bytes & 0x0F) - (zp ? zp[j] : zero)) * scale[j];
+  }
+}
+
+} // namespace atlas_memory
@@ -0,0 +1,64 @@
+#include "../include/atlas_memory/config_m2.hpp"
+#include "../include/atlas_memory/packing.hpp"
+
+#include <algorithm>
+
+namespace atlas_memory {
+
+// One pass per block column: test each block, copy the ones that hold a
+// non-zero (zero padded past the matrix edge)
+BlockSparseMatrix pack_block_sparse(const float *src, int rows, int cols,
+                                    int ld, int block_rows, int block_cols) {
+  // Blocks the driver cannot multiply: an empty (0 x 0) matrix
+  if (rows < 0 || cols < 0 || block_rows <= 0 ||
+      block_rows > int(config::DEFAULT_BK) || block_cols <= 0 ||
+      block_cols % int(config::NR) != 0)
+    return {};
+
+  BlockSparseMatrix m;
+  m.rows = rows;
+  m.cols = cols;
+  m.block_rows = block_rows;
+  m.block_cols = block_cols;
+
+  const int brows = m.block_row_count();
+  const int bcols = m.block_col_count();
+  const int block_size = block_rows * block_cols;
+
+  m.col_ptr.assign(1, 0);
+
+  for (int c = 0; c < bcols; ++c) {
+    const int j0 = c * block_cols;
+    const int w = std::min(block_cols, cols - j0);
+
+    for (int r = 0; r < brows; ++r) {
+      const int k0 = r * block_rows;
+      const int h = std::min(block_rows, rows - k0);
+
+      bool nonzero = false;
+      for (int k = 0; k < h && !nonzero; ++k)
+        for (int j = 0; j < w; ++j)
+          if (src[(k0 + k) * ld + j0 + j] != 0.0f) {
+            nonzero = true;
+            break;
+          }
+
+      if (!nonzero)
+        continue;
+
+      m.row_idx.push_back(r);
+      m.values.resize(m.values.size() + block_size, 0.0f);
+      float *dst = m.values.data() + m.values.size() - block_size;
+
+      for (int k = 0; k < h; ++k)
+        std::copy(src + (k0 + k) * ld + j0, src + (k0 + k) * ld + j0 + w,
+                  dst + k * block_cols);
+    }
+
+    m.col_ptr.push_back(m.nnz_blocks());
+  }
+
+  return m;
+}
+
+} // namespace atlas_memory
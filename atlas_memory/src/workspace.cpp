@@ -7,54 +7,97 @@
 
 namespace atlas_memory {
 
-Workspace::Workspace(std::size_t BM, std::size_t BN, std::size_t BK,
-                     std::size_t MR, std::size_t NR)
+template <class T>
+BasicWorkspace<T>::BasicWorkspace(std::size_t BM, std::size_t BN,
+                                  std::size_t BK, std::size_t MR,
+                                  std::size_t NR, std::size_t scratch_bytes)
     : BM_(BM), BN_(BN), BK_(BK), MR_(MR), NR_(NR) {
-  auto layout = compute_layout(BM_, BN_, BK_, MR_, NR_);
+  auto layout =
+      compute_layout(BM_, BN_, BK_, MR_, NR_, scratch_bytes, sizeof(T));
 
   total_bytes_ = layout.total_bytes;
   a_bytes_ = layout.a.bytes;
   b_bytes_ = layout.b.bytes;
   accum_bytes_ = layout.accum.bytes;
+  scratch_bytes_ = layout.scratch.bytes;
 
   allocate(total_bytes_);
   pre_touch();
 
-  a_ptr_ = reinterpret_cast<float *>(reinterpret_cast<char *>(base_) +
-                                     layout.a.offset);
+  a_ptr_ = reinterpret_cast<T *>(reinterpret_cast<char *>(base_) +
+                                 layout.a.offset);
 
-  b_ptr_ = reinterpret_cast<float *>(reinterpret_cast<char *>(base_) +
-                                     layout.b.offset);
+  b_ptr_ = reinterpret_cast<T *>(reinterpret_cast<char *>(base_) +
+                                 layout.b.offset);
 
-  accum_ptr_ = reinterpret_cast<float *>(reinterpret_cast<char *>(base_) +
-                                         layout.accum.offset);
+  accum_ptr_ = reinterpret_cast<T *>(reinterpret_cast<char *>(base_) +
+                                     layout.accum.offset);
+
+  scratch_ptr_ = reinterpret_cast<T *>(reinterpret_cast<char *>(base_) +
+                                       layout.scratch.offset);
 }
 
-Workspace::~Workspace() {
+template <class T> BasicWorkspace<T>::~BasicWorkspace() {
   if (base_)
     std::free(base_);
 }
 
-void Workspace::allocate(std::size_t bytes) {
+template <class T> void BasicWorkspace<T>::allocate(std::size_t bytes) {
   int res = posix_memalign(&base_, config::SIMD_ALIGNMENT, bytes);
   assert(res == 0);
 }
 
-void Workspace::pre_touch() {
+template <class T> void BasicWorkspace<T>::pre_touch() {
   char *ptr = reinterpret_cast<char *>(base_);
   for (std::size_t i = 0; i < total_bytes_; i += config::PAGE_SIZE)
     ptr[i] = 0;
 }
 
-float *Workspace::packA() noexcept { return a_ptr_; }
-float *Workspace::packB() noexcept { return b_ptr_; }
-float *Workspace::accum() noexcept { return accum_ptr_; }
+template <class T> T *BasicWorkspace<T>::packA() noexcept { return a_ptr_; }
+template <class T> T *BasicWorkspace<T>::packB() noexcept { return b_ptr_; }
+template <class T> T *BasicWorkspace<T>::accum() noexcept {
+  return accum_ptr_;
+}
+template <class T> T *BasicWorkspace<T>::scratch() noexcept {
+  return scratch_ptr_;
+}
+
+template <class T> std::size_t BasicWorkspace<T>::block_m() const noexcept {
+  return BM_;
+}
+template <class T> std::size_t BasicWorkspace<T>::block_n() const noexcept {
+  return BN_;
+}
+template <class T> std::size_t BasicWorkspace<T>::block_k() const noexcept {
+  return BK_;
+}
+
+template <class T>
+std::size_t BasicWorkspace<T>::packA_capacity() const noexcept {
+  return a_bytes_;
+}
+template <class T>
+std::size_t BasicWorkspace<T>::packB_capacity() const noexcept {
+  return b_bytes_;
+}
+template <class T>
+std::size_t BasicWorkspace<T>::accum_capacity() const noexcept {
+  return accum_bytes_;
+}
+template <class T>
+std::size_t BasicWorkspace<T>::scratch_capacity() const noexcept {
+  return scratch_bytes_;
+}
+template <class T>
+std::size_t BasicWorkspace<T>::total_capacity() const noexcept {
+  return total_bytes_;
+}
 
-std::size_t Workspace::packA_capacity() const noexcept { return a_bytes_; }
-std::size_t Workspace::packB_capacity() const noexcept { return b_bytes_; }
-std::size_t Workspace::accum_capacity() const noexcept { return accum_bytes_; }
-std::size_t Workspace::total_capacity() const noexcept { return total_bytes_; }
+template <class T> void BasicWorkspace<T>::reset() noexcept {
+  std::memset(accum_ptr_, 0, accum_bytes_);
+}
 
-void Workspace::reset() noexcept { std::memset(accum_ptr_, 0, accum_bytes_); }
+template class BasicWorkspace<float>;
+template class BasicWorkspace<double>;
 
 } // namespace atlas_memory
@@ -0,0 +1,168 @@
+#include "harness.hpp"
+
+#include "../gemm/kernels.hpp"
+
+#include <map>
+#include <random>
+
+// Block-size sweep of the packed drivers: a BM x BN x BK grid plus random
+// samples per shape class. Every configuration becomes one CSV / JSON
+// record (BM, BN, BK, MR, NR columns: pivot on any two for a heatmap);
+// the summary flags shapes where the M2 defaults are measurably beaten.
+//
+//   benchmark_block_sizes [--driver v6|v5] [--classes square,large_k]
+//                         [--grid 64,128,256,512] [--samples 16]
+//                         [--csv block_sizes.csv] [--json out.json]
+//                         [--min-reps N] [--max-time S] [--target-ci C]
+
+using namespace gemm;
+
+struct ShapeClass {
+  const char *name;
+  std::size_t M, N, K;
+};
+
+static const std::vector<ShapeClass> shape_classes = {
+    {"square", 1024, 1024, 1024},   {"tall_skinny", 4096, 256, 1024},
+    {"wide", 256, 4096, 1024},      {"large_k", 512, 512, 4096},
+    {"small", 256, 256, 256},
+};
+
+static std::string key(const BlockSizes &b) {
+  return std::to_string(b.BM) + "x" + std::to_string(b.BN) + "x" +
+         std::to_string(b.BK);
+}
+
+// Grid (every combination of the listed sizes), the defaults, then
+// random multiples of MR / NR in [32, 1024]
+static std::vector<BlockSizes> configurations(const std::vector<index_t> &grid,
+                                              std::size_t samples) {
+  std::vector<BlockSizes> out;
+  std::map<std::string, bool> seen;
+
+  auto add = [&](const BlockSizes &b) {
+    if (!seen[key(b)]) {
+      seen[key(b)] = true;
+      out.push_back(b);
+    }
+  };
+
+  add(BlockSizes{});
+  for (index_t bm : grid)
+    for (index_t bn : grid)
+      for (index_t bk : grid)
+        add({bm, bn, bk});
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<index_t> step(4, 128); // x 8
+  for (std::size_t s = 0; s < samples; ++s)
+    add({8 * step(rng), 8 * step(rng), 8 * step(rng)});
+
+  return out;
+}
+
+int main(int argc, char **argv) {
+  using namespace bench;
+
+  Args args(argc, argv);
+
+  // Many configurations: shorter measurements than the GEMM benchmark
+  RunOptions opts = args.run_options();
+  opts.min_reps = std::size_t(args.get("--min-reps", 3.0));
+  opts.max_seconds = args.get("--max-time", 0.5);
+
+  const std::string driver = args.get("--driver", std::string("v6"));
+  const auto class_filter = args.list("--classes");
+
+  std::vector<index_t> grid;
+  for (const std::string &g : args.list("--grid"))
+    grid.push_back(index_t(std::stoul(g)));
+  if (grid.empty())
+    grid = {64, 128, 256, 512};
+
+  const std::vector<BlockSizes> configs = configurations(
+      grid, std::size_t(args.get("--samples", 16.0)));
+
+  std::vector<Record> records;
+  std::vector<std::string> losses;
+
+  for (const ShapeClass &sc : shape_classes) {
+    if (!class_filter.empty() &&
+        std::find(class_filter.begin(), class_filter.end(), sc.name) ==
+            class_filter.end())
+      continue;
+
+    print_table_header(std::string("Block sizes (") + driver + "): " +
+                       sc.name);
+
+    std::vector<float> A(sc.M * sc.K), B(sc.K * sc.N), C(sc.M * sc.N);
+    fill_matrix(A);
+    fill_matrix(B);
+    GemmConfig cfg{sc.M, sc.N, sc.K, sc.K, sc.N, sc.N};
+
+    const Record *def = nullptr, *best = nullptr;
+    std::size_t first = records.size();
+
+    for (const BlockSizes &bs : configs) {
+      Record r;
+      r.kernel = key(bs);
+      r.scenario = sc.name;
+      r.M = sc.M, r.N = sc.N, r.K = sc.K;
+      r.params = {{"driver", driver},
+                  {"BM", std::to_string(bs.BM)},
+                  {"BN", std::to_string(bs.BN)},
+                  {"BK", std::to_string(bs.BK)},
+                  {"MR", std::to_string(atlas_memory::config::MR)},
+                  {"NR", std::to_string(atlas_memory::config::NR)}};
+
+      r.stats = measure(
+          [&] {
+            if (driver == "v5")
+              gemm_v5_packed_neon(A.data(), B.data(), C.data(), cfg, bs);
+            else
+              gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs);
+          },
+          opts);
+
+      print_record(r);
+      records.push_back(std::move(r));
+    }
+
+    for (std::size_t i = first; i < records.size(); ++i) {
+      if (i == first)
+        def = &records[i]; // defaults are always the first configuration
+      if (!best || records[i].stats.median < best->stats.median)
+        best = &records[i];
+    }
+
+    // Flag only wins beyond the noise of both measurements
+    double gain = def->stats.median / best->stats.median - 1.0;
+    double noise = std::max(0.03, 2.0 * (def->stats.ci + best->stats.ci));
+
+    std::cout << std::fixed << std::setprecision(2) << "best "
+              << best->kernel << ": "
+              << gflops(sc.M, sc.N, sc.K, best->stats.median)
+              << " GFLOP/s, defaults " << def->kernel << ": "
+              << gflops(sc.M, sc.N, sc.K, def->stats.median) << " GFLOP/s";
+
+    if (best != def && gain > noise) {
+      std::cout << "  <-- defaults lose " << std::setprecision(1)
+                << 100.0 * gain << "%";
+      losses.push_back(std::string(sc.name) + ": " + best->kernel);
+    }
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+  }
+
+  std::cout << "\n=== Summary ===\n";
+  if (losses.empty())
+    std::cout << "M2 defaults are within noise of the best configuration "
+                 "for every shape class\n";
+  for (const std::string &l : losses)
+    std::cout << "defaults lose on " << l << "\n";
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string("block_sizes.csv")),
+                         "block_sizes", records);
+  return ok ? 0 : 1;
+}
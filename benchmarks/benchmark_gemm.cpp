@@ -0,0 +1,180 @@
+#include "harness.hpp"
+
+#include "../gemm/kernels.hpp"
+
+#ifdef ATLAS_HAVE_OPENBLAS
+#include <cblas.h>
+#endif
+
+// Unified GEMM benchmark: every registered kernel over a list of shape
+// scenarios, repeated to a confidence target, JSON / CSV output.
+//
+//   benchmark_gemm [--kernels v5,v6,openblas] [--scenarios square,large_k]
+//                  [--json out.json] [--csv out.csv] [--list]
+//                  [--min-reps N] [--max-reps N] [--max-time S]
+//                  [--target-ci 0.02] [--flush] [--all-sizes] [--counters]
+//
+// --counters: one extra call under hardware counters per record (IPC,
+// miss rates, FLOPs/cycle columns), plus the per-phase breakdown when the
+// library was built with ATLAS_PERF_COUNTERS.
+
+using namespace gemm;
+
+using GemmFn = void (*)(const float *, const float *, float *,
+                        const GemmConfig &);
+
+// ================================================================
+// Kernel registry
+// ================================================================
+struct KernelEntry {
+  const char *name;
+  GemmFn fn;
+  double max_gflop; // larger problems are skipped unless --all-sizes
+};
+
+#ifdef ATLAS_HAVE_OPENBLAS
+static void openblas_sgemm(const float *A, const float *B, float *C,
+                           const GemmConfig &cfg) {
+  cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, int(cfg.M),
+              int(cfg.N), int(cfg.K), 1.0f, A, int(cfg.lda), B, int(cfg.ldb),
+              1.0f, C, int(cfg.ldc));
+}
+#endif
+
+static void strassen(const float *A, const float *B, float *C,
+                     const GemmConfig &cfg) {
+  gemm_strassen(A, B, C, cfg);
+}
+
+static const std::vector<KernelEntry> &registry() {
+  static const std::vector<KernelEntry> kernels = {
+      {"v0", gemm_v0_naive, 0.5},
+      {"v1", gemm_v1_loop_reorder, 2.0},
+      {"v2", gemm_v2_blocked, 4.0},
+      {"v3", gemm_v3_scalar_tile, 8.0},
+      {"v4_4x4", gemm_v4_neon_4x4, 1e9},
+      {"v4_8x8", gemm_v4_neon_8x8, 1e9},
+      {"v5", gemm_v5_packed_neon, 1e9},
+      {"v6", gemm_v6_parallel, 1e9},
+      {"dispatch", gemm_dispatch, 1e9},
+      {"strassen", strassen, 1e9},
+#ifdef ATLAS_HAVE_OPENBLAS
+      {"openblas", openblas_sgemm, 1e9},
+#endif
+  };
+  return kernels;
+}
+
+// ================================================================
+// Scenarios (the shape sets of the per-version benchmarks)
+// ================================================================
+struct Shape {
+  std::size_t M, N, K;
+};
+
+struct Scenario {
+  const char *name;
+  std::vector<Shape> shapes;
+};
+
+static std::vector<Scenario> scenarios() {
+  std::vector<Scenario> s;
+
+  Scenario square{"square", {}};
+  for (std::size_t n = 64; n <= 2048; n *= 2)
+    square.shapes.push_back({n, n, n});
+  s.push_back(square);
+
+  s.push_back({"tall_skinny",
+               {{128, 64, 1024}, {512, 64, 1024}, {2048, 64, 1024}}});
+  s.push_back({"wide", {{64, 128, 1024}, {64, 512, 1024}, {64, 2048, 1024}}});
+  s.push_back({"large_k", {{256, 256, 256}, {256, 256, 1024},
+                           {256, 256, 4096}}});
+  s.push_back({"cache_stress", {{384, 384, 384}, {768, 768, 768},
+                                {1536, 1536, 1536}}});
+  s.push_back({"gemv", {{4096, 1, 4096}, {1, 4096, 4096}}});
+  return s;
+}
+
+template <class T>
+static bool selected(const std::vector<std::string> &filter, const T &name) {
+  return filter.empty() ||
+         std::find(filter.begin(), filter.end(), name) != filter.end();
+}
+
+int main(int argc, char **argv) {
+  using namespace bench;
+
+  Args args(argc, argv);
+
+  if (args.flag("--list")) {
+    for (const KernelEntry &k : registry())
+      std::cout << "kernel   " << k.name << "\n";
+    for (const Scenario &s : scenarios())
+      std::cout << "scenario " << s.name << "\n";
+    return 0;
+  }
+
+  const RunOptions opts = args.run_options();
+  const auto kernels = args.list("--kernels");
+  const auto scenario_filter = args.list("--scenarios");
+  const bool all_sizes = args.flag("--all-sizes");
+  const bool counters = args.flag("--counters");
+
+  if (counters && !gemm::perf::CounterSet().available())
+    std::cerr << "hardware counters unavailable (no perf_event_open, or "
+                 "perf_event_paranoid too high): columns will read nan\n";
+
+  std::vector<Record> records;
+
+  for (const Scenario &sc : scenarios()) {
+    if (!selected(scenario_filter, std::string(sc.name)))
+      continue;
+
+    print_table_header(std::string("GEMM benchmark: ") + sc.name);
+
+    for (const Shape &sh : sc.shapes) {
+      std::vector<float> A(sh.M * sh.K), B(sh.K * sh.N), C(sh.M * sh.N);
+      fill_matrix(A);
+      fill_matrix(B);
+
+      GemmConfig cfg{sh.M, sh.N, sh.K, sh.K, sh.N, sh.N};
+      double gflop = 2.0 * sh.M * sh.N * sh.K / 1e9;
+
+      for (const KernelEntry &k : registry()) {
+        if (!selected(kernels, std::string(k.name)))
+          continue;
+        if (!all_sizes && gflop > k.max_gflop)
+          continue;
+
+        // C is not reset between repetitions: the accumulate kernels
+        // only grow it, the timing is unaffected
+        std::fill(C.begin(), C.end(), 0.0f);
+
+        Record r;
+        r.kernel = k.name;
+        r.scenario = sc.name;
+        r.M = sh.M, r.N = sh.N, r.K = sh.K;
+        r.stats = measure([&] { k.fn(A.data(), B.data(), C.data(), cfg); },
+                          opts);
+
+        print_record(r);
+
+        if (counters) {
+          gemm::perf::reset_phase_counts();
+          auto c = gemm::perf::count(
+              [&] { k.fn(A.data(), B.data(), C.data(), cfg); });
+          add_counter_params(r, c);
+          print_counters(c, gflop * 1e9);
+          print_phase_counts();
+        }
+
+        records.push_back(std::move(r));
+      }
+    }
+  }
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string()), "gemm", records);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,383 @@
+#include "harness.hpp"
+
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../gemm/kernels.hpp"
+
+#ifdef ATLAS_INSTRUMENT
+#include "../gemm/instrument.hpp"
+#endif
+
+#include <bit>
+#include <cstring>
+
+// When does packing pay off? Two parts:
+//
+// ratio:     pack_A / pack_B sweeps with the traffic of one v5 call (A is
+//            packed once per column block, B once per row block), as
+//            GB/s against memcpy of the same blocks, and the pack:compute
+//            time ratio of v5, per shape x leading dimension x block
+//            sizes. Leading dimensions: dense, padded by one cache line,
+//            and a power of two (>= 4096 floats: every row of a block in
+//            the same L1 sets). ATLAS_INSTRUMENT builds take the ratio
+//            from the driver's own phase ticks instead of the sweeps.
+// threshold: streaming kernels (no packing) against the packed v6 as M
+//            (N) grows, and the largest M (N) the dispatcher should
+//            still route to them (SKINNY_MAX in gemm/dispatch.cpp).
+//
+//   benchmark_packing [--part ratio|threshold|both] [--shapes square,odd]
+//                     [--ld dense,padded,pow2]
+//                     [--blocks 256x256x256,128x128x128]
+//                     [--skinny-size 1024] [--json out.json] [--csv out.csv]
+//                     [--min-reps N] [--max-time S] [--target-ci C]
+
+using namespace gemm;
+using namespace bench;
+
+struct Shape {
+  const char *name;
+  std::size_t M, N, K;
+};
+
+static const std::vector<Shape> shapes = {
+    {"square", 1024, 1024, 1024},   {"odd", 1000, 1000, 1000},
+    {"large_k", 256, 256, 4096},    {"small", 128, 128, 128},
+    {"tall_skinny", 2048, 128, 512}, {"wide", 128, 2048, 512},
+};
+
+// Leading dimension of a row of `cols` floats
+static std::size_t leading_dim(const std::string &ld, std::size_t cols) {
+  if (ld == "padded")
+    return cols + 16; // one 64-byte line
+  if (ld == "pow2")
+    return std::max<std::size_t>(4096, std::bit_ceil(cols));
+  return cols;
+}
+
+static BlockSizes parse_blocks(const std::string &s) {
+  BlockSizes b;
+  std::sscanf(s.c_str(), "%zux%zux%zu", &b.BM, &b.BN, &b.BK);
+  return clamp_block_sizes(b); // the sweeps below step by these
+}
+
+static std::string fixed(double v, int digits) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(digits) << v;
+  return os.str();
+}
+
+// Every record carries the same columns (CSV header from the first one)
+static void set_params(Record &r, const std::string &kind,
+                       const std::string &ld, std::size_t lda,
+                       std::size_t ldb, const BlockSizes &b) {
+  r.params = {{"kind", kind},
+              {"ld_case", ld},
+              {"lda", std::to_string(lda)},
+              {"ldb", std::to_string(ldb)},
+              {"BM", std::to_string(b.BM)},
+              {"BN", std::to_string(b.BN)},
+              {"BK", std::to_string(b.BK)},
+              {"pack_gbs", ""},
+              {"memcpy_gbs", ""},
+              {"pack_compute", ""},
+              {"ratio_source", ""},
+              {"speedup", ""}};
+}
+
+static void set_param(Record &r, const std::string &key,
+                      const std::string &value) {
+  for (auto &p : r.params)
+    if (p.first == key)
+      p.second = value;
+}
+
+// ================================================================
+// Pack sweeps: every block of one operand once, as the drivers cut it
+// ================================================================
+static void sweep_A(float *dst, const float *A, std::size_t M, std::size_t K,
+                    std::size_t lda, const BlockSizes &b) {
+  for (std::size_t ii = 0; ii < M; ii += b.BM)
+    for (std::size_t kk = 0; kk < K; kk += b.BK)
+      atlas_memory::pack_A(dst, A + ii * lda + kk, int(std::min(b.BM, M - ii)),
+                           int(std::min(b.BK, K - kk)), int(lda));
+}
+
+static void sweep_B(float *dst, const float *B, std::size_t K, std::size_t N,
+                    std::size_t ldb, const BlockSizes &b) {
+  for (std::size_t kk = 0; kk < K; kk += b.BK)
+    for (std::size_t jj = 0; jj < N; jj += b.BN)
+      atlas_memory::pack_B(dst, B + kk * ldb + jj, int(std::min(b.BK, K - kk)),
+                           int(std::min(b.BN, N - jj)), int(ldb));
+}
+
+// Same blocks, same destination, contiguous source
+static void sweep_memcpy(float *dst, const float *src, std::size_t rows,
+                         std::size_t cols, std::size_t block_rows,
+                         std::size_t block_cols) {
+  const float *s = src;
+  for (std::size_t i = 0; i < rows; i += block_rows)
+    for (std::size_t j = 0; j < cols; j += block_cols) {
+      std::size_t n = std::min(block_rows, rows - i) *
+                      std::min(block_cols, cols - j);
+      std::memcpy(dst, s, n * sizeof(float));
+      s += n;
+    }
+}
+
+// Read + write of every element of a rows x cols operand
+static double gbs(std::size_t rows, std::size_t cols, double t) {
+  return t > 0 ? 2.0 * sizeof(float) * rows * cols / t / 1e9 : 0.0;
+}
+
+// ================================================================
+// Part 1: pack bandwidth and pack:compute ratio
+// ================================================================
+static void print_ratio_header() {
+  std::cout << "\n=== Packing overhead (v5, single thread) ===\n"
+            << std::setw(12) << "shape" << std::setw(8) << "ld"
+            << std::setw(13) << "BMxBNxBK" << std::setw(10) << "A GB/s"
+            << std::setw(10) << "B GB/s" << std::setw(10) << "memcpy"
+            << std::setw(10) << "GFLOP/s" << std::setw(10) << "pack ms"
+            << std::setw(10) << "comp ms" << std::setw(11) << "pack:comp"
+            << "\n"
+            << std::string(104, '-') << "\n";
+}
+
+static void run_ratio(const Args &args, const RunOptions &opts,
+                      std::vector<Record> &records) {
+  const auto shape_filter = args.list("--shapes");
+  auto ld_cases = args.list("--ld");
+  if (ld_cases.empty())
+    ld_cases = {"dense", "padded", "pow2"};
+
+  std::vector<BlockSizes> blocks;
+  for (const std::string &b : args.list("--blocks"))
+    blocks.push_back(parse_blocks(b));
+  if (blocks.empty())
+    blocks = {BlockSizes{}, {128, 128, 128}, {64, 64, 64}};
+
+  print_ratio_header();
+
+  for (const Shape &sh : shapes) {
+    if (!shape_filter.empty() &&
+        std::find(shape_filter.begin(), shape_filter.end(), sh.name) ==
+            shape_filter.end())
+      continue;
+
+    for (const std::string &ld : ld_cases) {
+      const std::size_t lda = leading_dim(ld, sh.K);
+      const std::size_t ldb = leading_dim(ld, sh.N);
+
+      std::vector<float> A(sh.M * lda), B(sh.K * ldb), C(sh.M * sh.N);
+      fill_matrix(A);
+      fill_matrix(B);
+      std::vector<float> contiguous(std::max(sh.M * sh.K, sh.K * sh.N));
+      fill_matrix(contiguous);
+
+      const GemmConfig cfg{sh.M, sh.N, sh.K, lda, ldb, sh.N};
+
+      for (const BlockSizes &b : blocks) {
+        std::vector<float> dst(std::max(b.BM, b.BN) * b.BK);
+
+        auto record = [&](const char *kernel, const char *kind) {
+          Record r;
+          r.kernel = kernel;
+          r.scenario = sh.name;
+          r.M = sh.M, r.N = sh.N, r.K = sh.K;
+          set_params(r, kind, ld, lda, ldb, b);
+          return r;
+        };
+
+        // Standalone sweeps
+        Record ra = record("pack_A", "pack");
+        ra.stats = measure(
+            [&] { sweep_A(dst.data(), A.data(), sh.M, sh.K, lda, b); }, opts);
+        Stats ca = measure(
+            [&] {
+              sweep_memcpy(dst.data(), contiguous.data(), sh.M, sh.K, b.BM,
+                           b.BK);
+            },
+            opts);
+
+        Record rb = record("pack_B", "pack");
+        rb.stats = measure(
+            [&] { sweep_B(dst.data(), B.data(), sh.K, sh.N, ldb, b); }, opts);
+        Stats cb = measure(
+            [&] {
+              sweep_memcpy(dst.data(), contiguous.data(), sh.K, sh.N, b.BK,
+                           b.BN);
+            },
+            opts);
+
+        const double a_gbs = gbs(sh.M, sh.K, ra.stats.median);
+        const double b_gbs = gbs(sh.K, sh.N, rb.stats.median);
+        const double memcpy_gbs =
+            (gbs(sh.M, sh.K, ca.median) + gbs(sh.K, sh.N, cb.median)) / 2.0;
+
+        set_param(ra, "pack_gbs", fixed(a_gbs, 2));
+        set_param(ra, "memcpy_gbs", fixed(gbs(sh.M, sh.K, ca.median), 2));
+        set_param(rb, "pack_gbs", fixed(b_gbs, 2));
+        set_param(rb, "memcpy_gbs", fixed(gbs(sh.K, sh.N, cb.median), 2));
+
+        // The driver: A once per column block, B once per row block
+        Record rv = record("v5", "gemm");
+        rv.stats = measure(
+            [&] { gemm_v5_packed_neon(A.data(), B.data(), C.data(), cfg, b); },
+            opts);
+
+        const double col_blocks = double((sh.N + b.BN - 1) / b.BN);
+        const double row_blocks = double((sh.M + b.BM - 1) / b.BM);
+        double pack_s = ra.stats.median * col_blocks +
+                        rb.stats.median * row_blocks;
+        double compute_s = std::max(rv.stats.median - pack_s, 0.0);
+        std::string source = "sweeps";
+
+#ifdef ATLAS_INSTRUMENT
+        // Phase ticks of the last timed call: packing as the driver sees
+        // it (warm or cold blocks, interleaved with the microkernel)
+        const instrument::CallStats call = instrument::last_call();
+        std::uint64_t pack = 0, comp = 0;
+        for (const instrument::WorkerStats &w : call.workers) {
+          pack += w.phase_ticks[std::size_t(instrument::Phase::PackA)] +
+                  w.phase_ticks[std::size_t(instrument::Phase::PackB)];
+          comp += w.phase_ticks[std::size_t(instrument::Phase::Microkernel)] +
+                  w.phase_ticks[std::size_t(instrument::Phase::Edge)];
+        }
+        if (pack + comp > 0) {
+          pack_s = rv.stats.median * double(pack) / double(pack + comp);
+          compute_s = rv.stats.median - pack_s;
+          source = "instrument";
+        }
+#endif
+
+        const std::string ratio =
+            compute_s > 0 ? fixed(pack_s / compute_s, 3) : "inf";
+        for (Record *r : {&ra, &rb, &rv}) {
+          set_param(*r, "pack_compute", ratio);
+          set_param(*r, "ratio_source", source);
+        }
+
+        std::cout << std::setw(12) << sh.name << std::setw(8) << ld
+                  << std::setw(13)
+                  << (std::to_string(b.BM) + "x" + std::to_string(b.BN) +
+                      "x" + std::to_string(b.BK))
+                  << std::fixed << std::setprecision(2) << std::setw(10)
+                  << a_gbs << std::setw(10) << b_gbs << std::setw(10)
+                  << memcpy_gbs << std::setw(10)
+                  << gflops(sh.M, sh.N, sh.K, rv.stats.median)
+                  << std::setw(10) << pack_s * 1e3 << std::setw(10)
+                  << compute_s * 1e3 << std::setw(11) << ratio << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+
+        records.push_back(std::move(ra));
+        records.push_back(std::move(rb));
+        records.push_back(std::move(rv));
+      }
+    }
+  }
+}
+
+// ================================================================
+// Part 2: streaming (no packing) vs packed as the skinny side grows
+// ================================================================
+
+// Largest dimension up to which the streaming kernel won at every point
+static std::size_t crossover(const std::vector<std::size_t> &dims,
+                             const std::vector<double> &speedup) {
+  std::size_t best = 0;
+  for (std::size_t i = 0; i < dims.size() && speedup[i] < 1.0; ++i)
+    best = dims[i];
+  return best;
+}
+
+static std::size_t run_threshold(bool skinny_m, std::size_t size,
+                                 const RunOptions &opts,
+                                 std::vector<Record> &records) {
+  static const std::vector<std::size_t> dims = {1,  2,  3,  4,  6,  8,
+                                                12, 16, 24, 32, 48, 64};
+
+  const char *side = skinny_m ? "M" : "N";
+  const std::string scenario = skinny_m ? "threshold_m" : "threshold_n";
+  std::cout << "\n=== Streaming vs packed: " << side << " sweep ("
+            << (skinny_m ? "N = K = " : "M = K = ") << size << ") ===\n"
+            << std::setw(6) << side << std::setw(14) << "stream ms"
+            << std::setw(14) << "packed ms" << std::setw(16)
+            << "packed speedup" << std::setw(10) << "winner" << "\n"
+            << std::string(60, '-') << "\n";
+
+  std::vector<double> speedups;
+  for (std::size_t d : dims) {
+    const std::size_t M = skinny_m ? d : size, N = skinny_m ? size : d,
+                      K = size;
+    std::vector<float> A(M * K), B(K * N), C(M * N);
+    fill_matrix(A);
+    fill_matrix(B);
+    const GemmConfig cfg{M, N, K, K, N, N};
+
+    Record rs, rp;
+    rs.kernel = skinny_m ? "skinny_m" : "skinny_n";
+    rp.kernel = "v6";
+    for (Record *r : {&rs, &rp}) {
+      r->scenario = scenario;
+      r->M = M, r->N = N, r->K = K;
+      set_params(*r, "threshold", "dense", K, N, BlockSizes{});
+    }
+
+    rs.stats = measure(
+        [&] {
+          if (skinny_m)
+            gemm_skinny_m(A.data(), B.data(), C.data(), cfg);
+          else
+            gemm_skinny_n(A.data(), B.data(), C.data(), cfg);
+        },
+        opts);
+    rp.stats = measure(
+        [&] { gemm_v6_parallel(A.data(), B.data(), C.data(), cfg); }, opts);
+
+    const double speedup = rs.stats.median / rp.stats.median;
+    speedups.push_back(speedup);
+    set_param(rs, "speedup", fixed(speedup, 3));
+    set_param(rp, "speedup", fixed(speedup, 3));
+
+    std::cout << std::setw(6) << d << std::fixed << std::setprecision(3)
+              << std::setw(14) << rs.stats.median * 1e3 << std::setw(14)
+              << rp.stats.median * 1e3 << std::setw(16) << speedup
+              << std::setw(10) << (speedup < 1.0 ? "stream" : "packed")
+              << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    records.push_back(std::move(rs));
+    records.push_back(std::move(rp));
+  }
+
+  return crossover(dims, speedups);
+}
+
+int main(int argc, char **argv) {
+  Args args(argc, argv);
+
+  // Many configurations: shorter measurements than the GEMM benchmark
+  RunOptions opts = args.run_options();
+  opts.min_reps = std::size_t(args.get("--min-reps", 3.0));
+  opts.max_seconds = args.get("--max-time", 0.3);
+
+  const std::string part = args.get("--part", std::string("both"));
+  std::vector<Record> records;
+
+  if (part == "ratio" || part == "both")
+    run_ratio(args, opts, records);
+
+  if (part == "threshold" || part == "both") {
+    const std::size_t size = std::size_t(args.get("--skinny-size", 1024.0));
+    const std::size_t max_m = run_threshold(true, size, opts, records);
+    const std::size_t max_n = run_threshold(false, size, opts, records);
+
+    std::cout << "\nRecommended dispatcher thresholds (no packing while "
+                 "streaming wins at every smaller size):\n"
+              << "  skinny M <= " << max_m << ", skinny N <= " << max_n
+              << "   (gemm/dispatch.cpp SKINNY_MAX: 4)\n";
+  }
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string()), "packing", records);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+#include "harness.hpp"
+
+#include "../gemm/kernels.hpp"
+#include "../gemm/shape_trace.hpp"
+
+#include <functional>
+#include <map>
+#include <tuple>
+
+#ifdef ATLAS_HAVE_OPENBLAS
+#include <cblas.h>
+#endif
+
+// Replay of a production shape trace (ATLAS_SHAPE_TRACE=path, see
+// gemm/shape_trace.hpp): every distinct shape (with its leading
+// dimensions) is timed on each selected kernel, and the throughput is
+// weighted by how often the trace called it:
+//
+//   weighted GFLOP/s = sum(calls x 2MNK) / sum(calls x median time)
+//
+// The recorded durations give the same figure for what production ran.
+//
+//   benchmark_replay --trace shapes.trace [--kernels v5,v6,dispatch,strassen]
+//                    [--bm 256 --bn 256 --bk 256] [--threads N]
+//                    [--max-shapes 200] [--top 20]
+//                    [--json out.json] [--csv out.csv]
+
+using namespace gemm;
+using namespace bench;
+
+// Distinct shape of the trace
+struct Shape {
+  GemmConfig cfg;
+  shape_trace::DType dtype;
+  std::size_t calls = 0;
+  double recorded_s = 0.0; // production time over all calls
+};
+
+static double flops(const GemmConfig &c) { return 2.0 * c.M * c.N * c.K; }
+
+static std::vector<Shape> distinct_shapes(
+    const std::vector<shape_trace::Record> &trace) {
+  std::map<std::tuple<std::uint32_t, std::uint32_t, std::uint32_t,
+                      std::uint32_t, std::uint32_t, std::uint32_t, int>,
+           Shape>
+      by_key;
+
+  for (const shape_trace::Record &r : trace) {
+    Shape &s = by_key[{r.M, r.N, r.K, r.lda, r.ldb, r.ldc, int(r.dtype)}];
+    s.cfg = {r.M, r.N, r.K, r.lda, r.ldb, r.ldc};
+    s.dtype = r.dtype;
+    ++s.calls;
+    s.recorded_s += double(r.time_ns) * 1e-9;
+  }
+
+  // Heaviest first: where production spent its time
+  std::vector<Shape> out;
+  for (auto &[key, s] : by_key)
+    out.push_back(s);
+  std::sort(out.begin(), out.end(), [](const Shape &a, const Shape &b) {
+    return a.recorded_s > b.recorded_s;
+  });
+  return out;
+}
+
+// ================================================================
+// Kernels (f64 entry empty: the kernel has no fp64 form)
+// ================================================================
+struct Kernel {
+  std::string name;
+  std::function<void(const float *, const float *, float *,
+                     const GemmConfig &)>
+      f32;
+  std::function<void(const double *, const double *, double *,
+                     const GemmConfig &)>
+      f64;
+};
+
+static std::vector<Kernel> kernels(const BlockSizes &bs,
+                                   const ParallelOptions &par) {
+  std::vector<Kernel> k;
+
+  k.push_back({"v5",
+               [bs](const float *A, const float *B, float *C,
+                    const GemmConfig &cfg) {
+                 gemm_v5_packed_neon(A, B, C, cfg, bs);
+               },
+               [bs](const double *A, const double *B, double *C,
+                    const GemmConfig &cfg) {
+                 gemm_v5_packed_neon(A, B, C, cfg, bs);
+               }});
+  k.push_back({"v6",
+               [bs, par](const float *A, const float *B, float *C,
+                         const GemmConfig &cfg) {
+                 gemm_v6_parallel(A, B, C, cfg, bs, par);
+               },
+               [bs, par](const double *A, const double *B, double *C,
+                         const GemmConfig &cfg) {
+                 gemm_v6_parallel(A, B, C, cfg, bs, par);
+               }});
+  k.push_back({"dispatch",
+               [](const float *A, const float *B, float *C,
+                  const GemmConfig &cfg) { gemm_dispatch(A, B, C, cfg); },
+               nullptr});
+  k.push_back({"strassen",
+               [](const float *A, const float *B, float *C,
+                  const GemmConfig &cfg) { gemm_strassen(A, B, C, cfg); },
+               nullptr});
+#ifdef ATLAS_HAVE_OPENBLAS
+  k.push_back(
+      {"openblas",
+       [](const float *A, const float *B, float *C, const GemmConfig &cfg) {
+         cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, int(cfg.M),
+                     int(cfg.N), int(cfg.K), 1.0f, A, int(cfg.lda), B,
+                     int(cfg.ldb), 1.0f, C, int(cfg.ldc));
+       },
+       [](const double *A, const double *B, double *C,
+          const GemmConfig &cfg) {
+         cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, int(cfg.M),
+                     int(cfg.N), int(cfg.K), 1.0, A, int(cfg.lda), B,
+                     int(cfg.ldb), 1.0, C, int(cfg.ldc));
+       }});
+#endif
+  return k;
+}
+
+// Operands laid out with the recorded leading dimensions
+template <class T, class Fn>
+static Stats time_shape(const Fn &fn, const GemmConfig &cfg,
+                        const RunOptions &opts) {
+  std::vector<T> A(cfg.M * std::max(cfg.lda, cfg.K)),
+      B(cfg.K * std::max(cfg.ldb, cfg.N)), C(cfg.M * std::max(cfg.ldc, cfg.N));
+  for (std::size_t i = 0; i < A.size(); ++i)
+    A[i] = T((i * 7 + 3) % 13) / T(13);
+  for (std::size_t i = 0; i < B.size(); ++i)
+    B[i] = T((i * 5 + 1) % 11) / T(11);
+
+  return measure([&] { fn(A.data(), B.data(), C.data(), cfg); }, opts);
+}
+
+int main(int argc, char **argv) {
+  Args args(argc, argv);
+
+  const std::string path = args.get("--trace", std::string());
+  std::vector<shape_trace::Record> trace;
+  if (path.empty() || !shape_trace::read(path, trace)) {
+    std::cerr << "usage: benchmark_replay --trace <file> (recorded with "
+                 "ATLAS_SHAPE_TRACE=<file>)\n";
+    return 1;
+  }
+
+  RunOptions opts = args.run_options();
+  opts.max_seconds = args.get("--max-time", 0.5);
+
+  BlockSizes bs;
+  bs.BM = index_t(args.get("--bm", double(bs.BM)));
+  bs.BN = index_t(args.get("--bn", double(bs.BN)));
+  bs.BK = index_t(args.get("--bk", double(bs.BK)));
+
+  ParallelOptions par;
+  par.threads = unsigned(args.get("--threads", 0.0));
+
+  std::vector<Shape> shapes = distinct_shapes(trace);
+
+  double total_s = 0.0, total_flops = 0.0;
+  for (const Shape &s : shapes) {
+    total_s += s.recorded_s;
+    total_flops += s.calls * flops(s.cfg);
+  }
+
+  // Replay the heaviest shapes; report how much of the traffic they cover
+  const std::size_t limit = std::size_t(args.get("--max-shapes", 200.0));
+  if (shapes.size() > limit)
+    shapes.resize(limit);
+
+  double covered_s = 0.0;
+  for (const Shape &s : shapes)
+    covered_s += s.recorded_s;
+
+  std::cout << "\n=== Trace " << path << " ===\n"
+            << trace.size() << " calls, " << shapes.size() << " of "
+            << distinct_shapes(trace).size() << " distinct shapes replayed ("
+            << std::fixed << std::setprecision(1)
+            << (total_s > 0 ? 100.0 * covered_s / total_s : 100.0)
+            << "% of recorded time)\n"
+            << "recorded: " << std::setprecision(2)
+            << (total_s > 0 ? total_flops / total_s / 1e9 : 0.0)
+            << " GFLOP/s weighted\n";
+  std::cout.unsetf(std::ios::floatfield);
+
+  const std::size_t top = std::size_t(args.get("--top", 20.0));
+  const auto filter = args.list("--kernels");
+  std::vector<Record> records;
+
+  for (const Kernel &k : kernels(bs, par)) {
+    if (!filter.empty() &&
+        std::find(filter.begin(), filter.end(), k.name) == filter.end())
+      continue;
+
+    print_table_header("Replay: " + k.name);
+
+    double weighted_flops = 0.0, weighted_s = 0.0;
+    std::size_t skipped = 0;
+
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+      const Shape &s = shapes[i];
+      const bool f64 = s.dtype == shape_trace::DType::F64;
+      if (f64 ? !k.f64 : !k.f32) {
+        ++skipped;
+        continue;
+      }
+
+      Record r;
+      r.kernel = k.name;
+      r.scenario = f64 ? "replay_f64" : "replay_f32";
+      r.M = s.cfg.M, r.N = s.cfg.N, r.K = s.cfg.K;
+      r.stats = f64 ? time_shape<double>(k.f64, s.cfg, opts)
+                    : time_shape<float>(k.f32, s.cfg, opts);
+      r.params = {{"lda", std::to_string(s.cfg.lda)},
+                  {"ldb", std::to_string(s.cfg.ldb)},
+                  {"ldc", std::to_string(s.cfg.ldc)},
+                  {"calls", std::to_string(s.calls)},
+                  {"recorded_s", std::to_string(s.recorded_s)}};
+
+      weighted_flops += s.calls * flops(s.cfg);
+      weighted_s += s.calls * r.stats.median;
+
+      if (i < top)
+        print_record(r);
+      records.push_back(std::move(r));
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << k.name
+              << ": weighted "
+              << (weighted_s > 0 ? weighted_flops / weighted_s / 1e9 : 0.0)
+              << " GFLOP/s, replay time " << std::setprecision(4)
+              << weighted_s << " s";
+    if (skipped)
+      std::cout << " (" << skipped << " fp64 shapes skipped)";
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+  }
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string()), "replay", records);
+  return ok ? 0 : 1;
+}
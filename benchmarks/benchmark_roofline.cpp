@@ -0,0 +1,379 @@
+#include "harness.hpp"
+
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../gemm/kernels.hpp"
+
+#include <arm_neon.h>
+#include <tuple>
+
+#ifdef ATLAS_HAVE_OPENBLAS
+#include <cblas.h>
+#endif
+
+// Empirical roofline of this host, and every GEMM kernel / shape placed
+// on it.
+//
+//   1. Peak FLOP/s: register-only FMA chains (scalar and NEON), on 1..N
+//      threads at once
+//   2. Bandwidth: STREAM-like read and triad kernels on working sets
+//      sized for L1, L2, beyond L2 (SLC / L3) and DRAM, 1..N threads
+//   3. Kernels: GFLOP/s and compulsory arithmetic intensity per shape,
+//      attainable = min(peak, AI * DRAM bandwidth) on the kernel's
+//      thread count, reported as % of attainable and compute / memory
+//      bound
+//
+//   benchmark_roofline [--threads 1,8] [--kernels v5,v6,openblas]
+//                      [--json roofline.json] [--csv roofline.csv]
+//                      [--max-time S] [--skip-kernels]
+//
+// profiling/roofline_plot.py draws the JSON.
+
+using namespace gemm;
+using namespace bench;
+
+// ================================================================
+// Concurrent runs: fn(thread_id) on n threads, timed as one call
+// ================================================================
+template <class Fn> static void run_threads(unsigned n, const Fn &fn) {
+  if (n == 1) {
+    fn(0u);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (unsigned t = 0; t < n; ++t)
+    threads.emplace_back(fn, t);
+  for (auto &th : threads)
+    th.join();
+}
+
+static volatile float sink;
+
+// ================================================================
+// Peak FLOPs: independent FMA chains, enough of them to cover the FMA
+// latency x pipe count (M2 P-core: 4 cycles x 4 pipes = 16)
+// ================================================================
+constexpr std::size_t FMA_ITERS = 1u << 22;
+
+static double fma_scalar_flops() { return 2.0 * 16 * FMA_ITERS; }
+
+static void fma_scalar() {
+  const float a = sink + 0.999999f, b = sink + 1e-6f;
+  float acc[16];
+  for (int k = 0; k < 16; ++k)
+    acc[k] = sink + float(k);
+
+  for (std::size_t it = 0; it < FMA_ITERS; ++it)
+    for (int k = 0; k < 16; ++k)
+      acc[k] = std::fma(acc[k], a, b);
+
+  float s = 0.0f;
+  for (float v : acc)
+    s += v;
+  sink = s;
+}
+
+static double fma_neon_flops() { return 2.0 * 4 * 24 * FMA_ITERS; }
+
+static void fma_neon() {
+  const float32x4_t a = vdupq_n_f32(sink + 0.999999f);
+  const float32x4_t b = vdupq_n_f32(sink + 1e-6f);
+  float32x4_t acc[24];
+  for (int k = 0; k < 24; ++k)
+    acc[k] = vdupq_n_f32(sink + float(k));
+
+  for (std::size_t it = 0; it < FMA_ITERS; ++it)
+    for (int k = 0; k < 24; ++k)
+      acc[k] = vfmaq_f32(b, acc[k], a);
+
+  float32x4_t s = acc[0];
+  for (int k = 1; k < 24; ++k)
+    s = vaddq_f32(s, acc[k]);
+  sink = vgetq_lane_f32(s, 0);
+}
+
+// ================================================================
+// Bandwidth: read (sum) and triad (a = b + s c) over per-thread arrays,
+// repeated to ~64 MB of traffic per thread and call
+// ================================================================
+struct Level {
+  const char *name;
+  std::size_t bytes; // working set per thread (all arrays)
+};
+
+static std::vector<Level> levels() {
+  using namespace atlas_memory::config;
+  return {{"L1", 48u << 10},
+          {"L2", L2_BYTES / 4},
+          {"SLC/L3", 2 * L2_BYTES},
+          {"DRAM", 256u << 20}};
+}
+
+static void read_kernel(const float *x, std::size_t n) {
+  float32x4_t acc[8];
+  for (int k = 0; k < 8; ++k)
+    acc[k] = vdupq_n_f32(0.0f);
+
+  for (std::size_t i = 0; i + 32 <= n; i += 32)
+    for (int k = 0; k < 8; ++k)
+      acc[k] = vaddq_f32(acc[k], vld1q_f32(x + i + 4 * k));
+
+  float32x4_t s = acc[0];
+  for (int k = 1; k < 8; ++k)
+    s = vaddq_f32(s, acc[k]);
+  sink = vgetq_lane_f32(s, 0);
+}
+
+static void triad_kernel(float *a, const float *b, const float *c,
+                         std::size_t n) {
+  const float32x4_t s = vdupq_n_f32(1.0001f);
+  for (std::size_t i = 0; i + 4 <= n; i += 4)
+    vst1q_f32(a + i, vfmaq_f32(vld1q_f32(b + i), s, vld1q_f32(c + i)));
+}
+
+struct Roof {
+  unsigned threads;
+  double peak_gflops = 0.0; // best FMA variant
+  std::vector<std::pair<std::string, double>> bandwidth; // GB/s per level
+
+  double dram() const {
+    return bandwidth.empty() ? 0.0 : bandwidth.back().second;
+  }
+};
+
+static std::vector<std::pair<std::string, std::string>>
+row(const std::string &kind, unsigned threads, double ai, double gf,
+    double bw, double attainable, const std::string &bound) {
+  auto num = [](double v) {
+    std::ostringstream os;
+    os << std::setprecision(5) << v;
+    return v > 0 ? os.str() : std::string();
+  };
+  return {{"kind", kind},
+          {"threads", std::to_string(threads)},
+          {"ai", num(ai)},
+          {"gflops", num(gf)},
+          {"bandwidth_gbs", num(bw)},
+          {"attainable_gflops", num(attainable)},
+          {"pct_attainable",
+           num(attainable > 0 ? 100.0 * gf / attainable : 0.0)},
+          {"bound", bound}};
+}
+
+static Roof measure_roof(unsigned threads, const RunOptions &opts,
+                         std::vector<Record> &records) {
+  Roof roof{threads, 0.0, {}};
+
+  std::cout << "\n=== Roof, " << threads << " thread"
+            << (threads > 1 ? "s" : "") << " ===\n";
+  std::cout << std::setw(12) << "" << std::setw(12) << "GFLOP/s" << "\n";
+
+  struct Variant {
+    const char *name;
+    void (*fn)();
+    double flops;
+  };
+  const Variant variants[] = {{"fma_scalar", fma_scalar, fma_scalar_flops()},
+                              {"fma_neon", fma_neon, fma_neon_flops()}};
+
+  for (const Variant &v : variants) {
+    Record r;
+    r.kernel = v.name;
+    r.scenario = "peak";
+    r.stats = measure([&] { run_threads(threads, [&](unsigned) { v.fn(); }); },
+                      opts);
+
+    double gf = v.flops * threads / r.stats.min / 1e9;
+    roof.peak_gflops = std::max(roof.peak_gflops, gf);
+    r.params = row("peak", threads, 0, gf, 0, 0, "");
+
+    std::cout << std::setw(12) << v.name << std::fixed << std::setprecision(2)
+              << std::setw(12) << gf << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+    records.push_back(std::move(r));
+  }
+
+  std::cout << std::setw(12) << "" << std::setw(12) << "GB/s read"
+            << std::setw(12) << "GB/s triad" << "\n";
+
+  for (const Level &lv : levels()) {
+    const std::size_t n = lv.bytes / sizeof(float) / 3; // triad: 3 arrays
+    const std::size_t passes =
+        std::max<std::size_t>(1, (64u << 20) / (n * sizeof(float)));
+
+    std::vector<std::vector<float>> a(threads), b(threads), c(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+      a[t].assign(n, 0.0f);
+      b[t].assign(n, 1.0f);
+      c[t].assign(n, 2.0f);
+    }
+
+    Stats read = measure(
+        [&] {
+          run_threads(threads, [&](unsigned t) {
+            for (std::size_t p = 0; p < passes; ++p)
+              read_kernel(b[t].data(), n);
+          });
+        },
+        opts);
+    Stats triad = measure(
+        [&] {
+          run_threads(threads, [&](unsigned t) {
+            for (std::size_t p = 0; p < passes; ++p)
+              triad_kernel(a[t].data(), b[t].data(), c[t].data(), n);
+          });
+        },
+        opts);
+
+    const double bytes = double(threads) * passes * n * sizeof(float);
+    const double read_gbs = bytes / read.min / 1e9;
+    const double triad_gbs = 3.0 * bytes / triad.min / 1e9;
+    const double best = std::max(read_gbs, triad_gbs);
+    roof.bandwidth.push_back({lv.name, best});
+
+    std::cout << std::setw(12) << lv.name << std::fixed
+              << std::setprecision(2) << std::setw(12) << read_gbs
+              << std::setw(12) << triad_gbs << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    for (auto [kernel, stats, gbs] :
+         {std::tuple{"read", read, read_gbs},
+          std::tuple{"triad", triad, triad_gbs}}) {
+      Record r;
+      r.kernel = kernel;
+      r.scenario = std::string("bandwidth_") + lv.name;
+      r.stats = stats;
+      r.params = row("bandwidth", threads, 0, 0, gbs, 0, "");
+      records.push_back(std::move(r));
+    }
+  }
+
+  return roof;
+}
+
+// ================================================================
+// Kernels on the roofline
+// ================================================================
+using GemmFn = void (*)(const float *, const float *, float *,
+                        const GemmConfig &);
+
+#ifdef ATLAS_HAVE_OPENBLAS
+static void openblas_sgemm(const float *A, const float *B, float *C,
+                           const GemmConfig &cfg) {
+  cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, int(cfg.M),
+              int(cfg.N), int(cfg.K), 1.0f, A, int(cfg.lda), B, int(cfg.ldb),
+              1.0f, C, int(cfg.ldc));
+}
+#endif
+
+struct KernelEntry {
+  const char *name;
+  GemmFn fn;
+  bool parallel; // placed against the all-thread roof
+};
+
+static const std::vector<KernelEntry> kernels = {
+    {"v5", gemm_v5_packed_neon, false},
+    {"v6", gemm_v6_parallel, true},
+    {"dispatch", gemm_dispatch, true},
+#ifdef ATLAS_HAVE_OPENBLAS
+    {"openblas", openblas_sgemm, true},
+#endif
+};
+
+struct Shape {
+  const char *scenario;
+  std::size_t M, N, K;
+};
+
+static const std::vector<Shape> shapes = {
+    {"square", 256, 256, 256},     {"square", 1024, 1024, 1024},
+    {"square", 2048, 2048, 2048},  {"tall_skinny", 2048, 64, 1024},
+    {"large_k", 256, 256, 4096},   {"gemv", 4096, 1, 4096},
+};
+
+int main(int argc, char **argv) {
+  Args args(argc, argv);
+
+  RunOptions opts = args.run_options();
+  opts.max_seconds = args.get("--max-time", 0.5);
+
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> counts;
+  for (const std::string &t : args.list("--threads"))
+    counts.push_back(unsigned(std::stoul(t)));
+  if (counts.empty())
+    counts = hw > 1 ? std::vector<unsigned>{1, hw} : std::vector<unsigned>{1};
+
+  std::vector<Record> records;
+  std::vector<Roof> roofs;
+  for (unsigned n : counts)
+    roofs.push_back(measure_roof(n, opts, records));
+
+  // Serial kernels against the fewest threads, parallel ones the most
+  auto roof_for = [&](bool parallel) -> const Roof & {
+    auto cmp = [](const Roof &a, const Roof &b) {
+      return a.threads < b.threads;
+    };
+    return parallel ? *std::max_element(roofs.begin(), roofs.end(), cmp)
+                    : *std::min_element(roofs.begin(), roofs.end(), cmp);
+  };
+
+  if (!args.flag("--skip-kernels")) {
+    const auto filter = args.list("--kernels");
+
+    std::cout << "\n=== Kernels on the roofline ===\n";
+    std::cout << std::setw(12) << "kernel" << std::setw(7) << "M"
+              << std::setw(7) << "N" << std::setw(7) << "K" << std::setw(8)
+              << "AI" << std::setw(10) << "GFLOP/s" << std::setw(12)
+              << "attainable" << std::setw(8) << "%" << std::setw(10)
+              << "bound" << "\n";
+    std::cout << std::string(81, '-') << "\n";
+
+    for (const Shape &sh : shapes) {
+      std::vector<float> A(sh.M * sh.K), B(sh.K * sh.N), C(sh.M * sh.N);
+      fill_matrix(A);
+      fill_matrix(B);
+      GemmConfig cfg{sh.M, sh.N, sh.K, sh.K, sh.N, sh.N};
+
+      for (const KernelEntry &k : kernels) {
+        if (!filter.empty() &&
+            std::find(filter.begin(), filter.end(), k.name) == filter.end())
+          continue;
+
+        const Roof &roof = roof_for(k.parallel);
+
+        Record r;
+        r.kernel = k.name;
+        r.scenario = sh.scenario;
+        r.M = sh.M, r.N = sh.N, r.K = sh.K;
+        r.stats = measure([&] { k.fn(A.data(), B.data(), C.data(), cfg); },
+                          opts);
+
+        const double ai = arithmetic_intensity(sh.M, sh.N, sh.K);
+        const double gf = gflops(sh.M, sh.N, sh.K, r.stats.median);
+        const double mem_roof = ai * roof.dram();
+        const double attainable = std::min(roof.peak_gflops, mem_roof);
+        const char *bound = mem_roof < roof.peak_gflops ? "memory" : "compute";
+
+        r.params = row("kernel", roof.threads, ai, gf, roof.dram(),
+                       attainable, bound);
+
+        std::cout << std::setw(12) << k.name << std::setw(7) << sh.M
+                  << std::setw(7) << sh.N << std::setw(7) << sh.K
+                  << std::fixed << std::setprecision(2) << std::setw(8) << ai
+                  << std::setw(10) << gf << std::setw(12) << attainable
+                  << std::setprecision(1) << std::setw(7)
+                  << 100.0 * gf / attainable << "%" << std::setw(10) << bound
+                  << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+        records.push_back(std::move(r));
+      }
+    }
+  }
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string()), "roofline",
+                         records);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+#include "harness.hpp"
+
+#include "../gemm/instrument.hpp"
+#include "../gemm/kernels.hpp"
+
+#include <numeric>
+#include <thread>
+
+// Thread scaling of the v6 driver. Strong scaling: fixed shapes on 1..N
+// workers, speedup t1 / tN and efficiency speedup / N. Weak scaling: M
+// grows with the worker count (constant rows per worker), efficiency
+// t1 / tN. One extra instrumented run per point reports per-worker busy
+// time, the idle fraction and the load imbalance (max / mean busy);
+// ATLAS_INSTRUMENT builds add the busy-time share of every GEMM phase;
+// ATLAS_TRACE builds write the instrumented runs as a Chrome trace
+// (--trace scaling.json, open in ui.perfetto.dev).
+//
+//   benchmark_scaling [--mode strong|weak|both] [--max-threads N]
+//                     [--threads 1,2,4,8] [--json out.json] [--csv out.csv]
+//                     [--trace scaling.json]
+//                     [--min-reps N] [--max-time S] [--target-ci C]
+
+using namespace gemm;
+
+struct Shape {
+  const char *name;
+  std::size_t M, N, K;
+};
+
+static const std::vector<Shape> strong_shapes = {
+    {"square", 2048, 2048, 2048},
+    {"tall_skinny", 4096, 256, 1024},
+    {"small", 512, 512, 512},
+};
+
+// Weak scaling: M rows per worker
+static const std::vector<Shape> weak_shapes = {
+    {"rows_256", 256, 1024, 1024},
+    {"rows_512", 512, 512, 2048},
+};
+
+struct Balance {
+  double busy_mean = 0.0, busy_max = 0.0;
+  double idle = 0.0;      // 1 - total busy / (workers * wall)
+  double imbalance = 1.0; // max / mean busy
+};
+
+static Balance balance(const ThreadStats &st) {
+  Balance b;
+  if (st.busy.empty() || st.wall <= 0.0)
+    return b;
+
+  double total = std::accumulate(st.busy.begin(), st.busy.end(), 0.0);
+  b.busy_mean = total / double(st.busy.size());
+  b.busy_max = *std::max_element(st.busy.begin(), st.busy.end());
+  b.idle = 1.0 - total / (double(st.busy.size()) * st.wall);
+  b.imbalance = b.busy_mean > 0.0 ? b.busy_max / b.busy_mean : 1.0;
+  return b;
+}
+
+static std::string fixed(double v, int digits) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(digits) << v;
+  return os.str();
+}
+
+static void print_scaling_header() {
+  std::cout << std::setw(8) << "threads" << std::setw(10) << "speedup"
+            << std::setw(8) << "eff" << std::setw(12) << "busy mean"
+            << std::setw(12) << "busy max" << std::setw(8) << "idle"
+            << std::setw(8) << "imbal" << "\n";
+}
+
+// One sweep over the worker counts on the shape returned by shape_for(n)
+template <class ShapeFn>
+static void sweep(const char *mode, const char *name, const ShapeFn &shape_for,
+                  const std::vector<unsigned> &counts,
+                  const bench::RunOptions &opts,
+                  std::vector<bench::Record> &records) {
+  using namespace bench;
+
+  print_table_header(std::string(mode) + " scaling: " + name);
+
+  const bool strong = std::string(mode) == "strong";
+  std::vector<Record> rows;
+  std::vector<Balance> balances;
+  double t1 = 0.0;
+
+  for (unsigned n : counts) {
+    const Shape sh = shape_for(n);
+
+    std::vector<float> A(sh.M * sh.K), B(sh.K * sh.N), C(sh.M * sh.N);
+    fill_matrix(A);
+    fill_matrix(B);
+    GemmConfig cfg{sh.M, sh.N, sh.K, sh.K, sh.N, sh.N};
+
+    ParallelOptions par;
+    par.threads = n;
+
+    Record r;
+    r.kernel = "v6 x" + std::to_string(n);
+    r.scenario = name;
+    r.M = sh.M, r.N = sh.N, r.K = sh.K;
+    r.stats = measure(
+        [&] { gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, {}, par); },
+        opts);
+    print_record(r);
+
+    ThreadStats st;
+    par.stats = &st;
+    trace::resume();
+    gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, {}, par);
+    trace::stop();
+
+#ifdef ATLAS_INSTRUMENT
+    // Share of the busy time per phase, summed over the workers
+    const instrument::CallStats call = instrument::last_call();
+    std::uint64_t busy = 0;
+    std::array<std::uint64_t, instrument::NUM_PHASES> phase{};
+    for (const instrument::WorkerStats &w : call.workers) {
+      busy += w.busy_ticks;
+      for (std::size_t p = 0; p < phase.size(); ++p)
+        phase[p] += w.phase_ticks[p];
+    }
+    for (std::size_t p = 0; p < phase.size(); ++p)
+      r.params.push_back({perf::phase_name(instrument::Phase(p)),
+                          fixed(busy ? double(phase[p]) / double(busy) : 0.0,
+                                3)});
+#endif
+
+    // Baseline: the first point, extrapolated to one worker (strong)
+    if (rows.empty())
+      t1 = r.stats.median * (strong ? double(n) : 1.0);
+
+    rows.push_back(std::move(r));
+    balances.push_back(balance(st));
+  }
+
+  print_scaling_header();
+
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    Record &r = rows[i];
+    const Balance &b = balances[i];
+    const unsigned n = counts[i];
+
+    double speedup, efficiency;
+    if (strong) {
+      speedup = t1 / r.stats.median;
+      efficiency = speedup / double(n);
+    } else {
+      // n / n0 times the work in the baseline's time: ideal is 100%
+      efficiency = t1 / r.stats.median;
+      speedup = efficiency * double(n) / double(counts.front());
+    }
+
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+              << std::setw(10) << speedup << std::setw(7)
+              << std::setprecision(1) << 100.0 * efficiency << "%"
+              << std::scientific << std::setprecision(3) << std::setw(12)
+              << b.busy_mean << std::setw(12) << b.busy_max << std::fixed
+              << std::setprecision(1) << std::setw(7) << 100.0 * b.idle
+              << "%" << std::setprecision(2) << std::setw(8) << b.imbalance
+              << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    // Ahead of the phase shares of instrumented builds
+    r.params.insert(r.params.begin(),
+                    {{"mode", mode},
+                     {"workers", std::to_string(n)},
+                     {"speedup", fixed(speedup, 3)},
+                     {"efficiency", fixed(efficiency, 3)},
+                     {"busy_mean", fixed(b.busy_mean, 6)},
+                     {"busy_max", fixed(b.busy_max, 6)},
+                     {"idle", fixed(b.idle, 3)},
+                     {"imbalance", fixed(b.imbalance, 3)}});
+    records.push_back(std::move(r));
+  }
+}
+
+int main(int argc, char **argv) {
+  using namespace bench;
+
+  Args args(argc, argv);
+
+  RunOptions opts = args.run_options();
+  opts.max_seconds = args.get("--max-time", 1.0);
+
+  const std::string mode = args.get("--mode", std::string("both"));
+
+  unsigned hw = std::thread::hardware_concurrency();
+  unsigned max_threads =
+      unsigned(args.get("--max-threads", double(hw ? hw : 4)));
+
+  // Default counts: 1, 2, 4, ... and max_threads itself
+  std::vector<unsigned> counts;
+  for (const std::string &t : args.list("--threads"))
+    counts.push_back(unsigned(std::stoul(t)));
+  if (counts.empty()) {
+    for (unsigned n = 1; n < max_threads; n *= 2)
+      counts.push_back(n);
+    counts.push_back(std::max(1u, max_threads));
+  }
+
+  // Only the instrumented runs are traced (resume / stop in sweep)
+  const std::string trace_path = args.get("--trace", std::string());
+  trace::start(std::size_t(1) << 20);
+  trace::stop();
+
+  std::vector<Record> records;
+
+  if (mode == "strong" || mode == "both")
+    for (const Shape &sh : strong_shapes)
+      sweep("strong", sh.name, [&](unsigned) { return sh; }, counts, opts,
+            records);
+
+  if (mode == "weak" || mode == "both")
+    for (const Shape &sh : weak_shapes)
+      sweep("weak", sh.name,
+            [&](unsigned n) {
+              return Shape{sh.name, sh.M * n, sh.N, sh.K};
+            },
+            counts, opts, records);
+
+  bool ok = save_results(args.get("--json", std::string()),
+                         args.get("--csv", std::string()), "scaling", records);
+
+  if (!trace_path.empty()) {
+#ifndef ATLAS_TRACE
+    std::cerr << "--trace: build with -DATLAS_TRACE=ON to record events\n";
+#endif
+    if (!trace::write_chrome_json(trace_path)) {
+      std::cerr << "cannot write " << trace_path << "\n";
+      ok = false;
+    }
+  }
+  return ok ? 0 : 1;
+}
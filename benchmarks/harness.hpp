@@ -0,0 +1,433 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+#include "../gemm/perf_counters.hpp"
+
+// Shared measurement harness of the benchmarks/ executables: repeated
+// timing until a confidence target, order statistics, host metadata and
+// JSON / CSV records.
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+// ================================================================
+// Repetition policy
+// ================================================================
+struct RunOptions {
+  std::size_t min_reps = 5;
+  std::size_t max_reps = 200;
+  double max_seconds = 2.0; // per measurement, after the warmup
+  double target_ci = 0.02;  // 95% CI half-width / mean
+  bool flush_cache = false; // evict caches before every repetition
+};
+
+struct Stats {
+  std::size_t reps = 0;
+  double min = 0, median = 0, p95 = 0, mean = 0, stddev = 0;
+  double ci = 0; // relative 95% CI half-width of the mean
+  std::vector<double> samples;
+};
+
+inline double percentile(std::vector<double> sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  std::sort(sorted.begin(), sorted.end());
+  std::size_t i = std::size_t(std::ceil(p * sorted.size()));
+  return sorted[std::min(sorted.size() - 1, i > 0 ? i - 1 : 0)];
+}
+
+inline Stats summarize(const std::vector<double> &samples) {
+  Stats s;
+  s.samples = samples;
+  s.reps = samples.size();
+  if (samples.empty())
+    return s;
+
+  s.min = *std::min_element(samples.begin(), samples.end());
+  s.median = percentile(samples, 0.5);
+  s.p95 = percentile(samples, 0.95);
+  s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / s.reps;
+
+  double var = 0.0;
+  for (double x : samples)
+    var += (x - s.mean) * (x - s.mean);
+  s.stddev = s.reps > 1 ? std::sqrt(var / (s.reps - 1)) : 0.0;
+  s.ci = s.mean > 0 ? 1.96 * s.stddev / std::sqrt(double(s.reps)) / s.mean
+                    : 0.0;
+  return s;
+}
+
+// Writes a buffer larger than the last-level cache (M2 SLC: 8 MB)
+inline void flush_caches() {
+  static std::vector<char> buf(64u << 20);
+  for (std::size_t i = 0; i < buf.size(); i += 64)
+    buf[i] = char(buf[i] + 1);
+}
+
+// One warmup call, then fn() timed until the CI target, max_reps or the
+// time budget (whichever first, never below min_reps)
+template <class Fn> inline Stats measure(const Fn &fn, const RunOptions &o) {
+  fn();
+
+  std::vector<double> samples;
+  double elapsed = 0.0;
+
+  while (samples.size() < o.max_reps) {
+    if (o.flush_cache)
+      flush_caches();
+
+    auto t0 = clock::now();
+    fn();
+    auto t1 = clock::now();
+
+    double t = std::chrono::duration<double>(t1 - t0).count();
+    samples.push_back(t);
+    elapsed += t;
+
+    if (samples.size() < o.min_reps)
+      continue;
+    if (elapsed >= o.max_seconds || summarize(samples).ci <= o.target_ci)
+      break;
+  }
+
+  return summarize(samples);
+}
+
+inline double gflops(std::size_t M, std::size_t N, std::size_t K, double t) {
+  return t > 0 ? 2.0 * M * N * K / (t * 1e9) : 0.0;
+}
+
+// FLOPs per byte of compulsory fp32 traffic (A, B, C once; as in
+// tests/benchmark_common.hpp)
+inline double arithmetic_intensity(std::size_t M, std::size_t N,
+                                   std::size_t K) {
+  double bytes = 4.0 * (double(M) * K + double(K) * N + double(M) * N);
+  return bytes > 0 ? 2.0 * M * N * K / bytes : 0.0;
+}
+
+// ================================================================
+// Host metadata
+// ================================================================
+struct HostInfo {
+  std::string hostname, os, arch, cpu, compiler, timestamp;
+  unsigned threads = 0;
+};
+
+inline std::string cpu_brand() {
+#if defined(__APPLE__)
+  char buf[256];
+  std::size_t len = sizeof(buf);
+  if (sysctlbyname("machdep.cpu.brand_string", buf, &len, nullptr, 0) == 0)
+    return buf;
+#else
+  std::ifstream in("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(in, line))
+    if (line.rfind("model name", 0) == 0 || line.rfind("CPU part", 0) == 0)
+      return line.substr(line.find(':') + 2);
+#endif
+  return "unknown";
+}
+
+inline HostInfo host_info() {
+  HostInfo h;
+
+  char name[256] = {};
+  gethostname(name, sizeof(name) - 1);
+  h.hostname = name;
+
+  struct utsname u;
+  if (uname(&u) == 0) {
+    h.os = std::string(u.sysname) + " " + u.release;
+    h.arch = u.machine;
+  }
+
+  h.cpu = cpu_brand();
+  h.threads = std::thread::hardware_concurrency();
+
+#if defined(__clang__)
+  h.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+  h.compiler = "gcc " __VERSION__;
+#else
+  h.compiler = "unknown";
+#endif
+
+  std::time_t now = std::time(nullptr);
+  char ts[32];
+  std::strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  h.timestamp = ts;
+  return h;
+}
+
+// ================================================================
+// Records and their JSON / CSV forms
+// ================================================================
+struct Record {
+  std::string kernel;
+  std::string scenario;
+  std::size_t M = 0, N = 0, K = 0;
+  Stats stats;
+  // Benchmark-specific columns (block sizes, thread count, ...)
+  std::vector<std::pair<std::string, std::string>> params;
+};
+
+inline std::string json_escape(const std::string &s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    if (c == '\n') {
+      out += "\\n";
+      continue;
+    }
+    out += c;
+  }
+  return out;
+}
+
+inline void write_json(std::ostream &os, const std::string &benchmark,
+                       const HostInfo &h, const std::vector<Record> &records) {
+  os << std::setprecision(9);
+  os << "{\n  \"benchmark\": \"" << json_escape(benchmark) << "\",\n";
+  os << "  \"host\": {\"hostname\": \"" << json_escape(h.hostname)
+     << "\", \"os\": \"" << json_escape(h.os) << "\", \"arch\": \""
+     << json_escape(h.arch) << "\", \"cpu\": \"" << json_escape(h.cpu)
+     << "\", \"threads\": " << h.threads << ", \"compiler\": \""
+     << json_escape(h.compiler) << "\", \"timestamp\": \"" << h.timestamp
+     << "\"},\n";
+  os << "  \"results\": [";
+
+  for (std::size_t r = 0; r < records.size(); ++r) {
+    const Record &rec = records[r];
+    const Stats &s = rec.stats;
+
+    os << (r ? ",\n" : "\n") << "    {\"kernel\": \""
+       << json_escape(rec.kernel) << "\", \"scenario\": \""
+       << json_escape(rec.scenario) << "\", \"M\": " << rec.M
+       << ", \"N\": " << rec.N << ", \"K\": " << rec.K;
+
+    for (const auto &[key, value] : rec.params)
+      os << ", \"" << json_escape(key) << "\": \"" << json_escape(value)
+         << "\"";
+
+    os << ", \"reps\": " << s.reps << ", \"min_s\": " << s.min
+       << ", \"median_s\": " << s.median << ", \"p95_s\": " << s.p95
+       << ", \"mean_s\": " << s.mean << ", \"stddev_s\": " << s.stddev
+       << ", \"ci\": " << s.ci
+       << ", \"gflops_median\": " << gflops(rec.M, rec.N, rec.K, s.median)
+       << ", \"gflops_best\": " << gflops(rec.M, rec.N, rec.K, s.min)
+       << ", \"samples_s\": [";
+    for (std::size_t i = 0; i < s.samples.size(); ++i)
+      os << (i ? ", " : "") << s.samples[i];
+    os << "]}";
+  }
+
+  os << "\n  ]\n}\n";
+}
+
+// One row per record; host metadata repeated so rows stay self-contained
+inline void write_csv(std::ostream &os, const HostInfo &h,
+                      const std::vector<Record> &records) {
+  os << std::setprecision(9);
+  os << "host,cpu,threads,kernel,scenario,M,N,K";
+  if (!records.empty())
+    for (const auto &p : records.front().params)
+      os << "," << p.first;
+  os << ",reps,min_s,median_s,p95_s,mean_s,stddev_s,ci,gflops_median,"
+        "gflops_best\n";
+
+  for (const Record &rec : records) {
+    const Stats &s = rec.stats;
+    os << h.hostname << ",\"" << h.cpu << "\"," << h.threads << ","
+       << rec.kernel << "," << rec.scenario << "," << rec.M << "," << rec.N
+       << "," << rec.K;
+    for (const auto &p : rec.params)
+      os << "," << p.second;
+    os << "," << s.reps << "," << s.min << "," << s.median << "," << s.p95
+       << "," << s.mean << "," << s.stddev << "," << s.ci << ","
+       << gflops(rec.M, rec.N, rec.K, s.median) << ","
+       << gflops(rec.M, rec.N, rec.K, s.min) << "\n";
+  }
+}
+
+// Writes JSON / CSV when a path is given ("-": stdout)
+inline bool save_results(const std::string &json_path,
+                         const std::string &csv_path,
+                         const std::string &benchmark,
+                         const std::vector<Record> &records) {
+  HostInfo h = host_info();
+  bool ok = true;
+
+  auto emit = [&](const std::string &path, auto &&writer) {
+    if (path.empty())
+      return;
+    if (path == "-") {
+      writer(std::cout);
+      return;
+    }
+    std::ofstream out(path);
+    if (!out) {
+      std::cerr << "cannot write " << path << "\n";
+      ok = false;
+      return;
+    }
+    writer(out);
+  };
+
+  emit(json_path, [&](std::ostream &os) {
+    write_json(os, benchmark, h, records);
+  });
+  emit(csv_path, [&](std::ostream &os) { write_csv(os, h, records); });
+  return ok;
+}
+
+// ================================================================
+// Human-readable table (stdout)
+// ================================================================
+inline void print_table_header(const std::string &name) {
+  std::cout << "\n=== " << name << " ===\n";
+  std::cout << std::setw(12) << "kernel" << std::setw(7) << "M"
+            << std::setw(7) << "N" << std::setw(7) << "K" << std::setw(6)
+            << "reps" << std::setw(12) << "median(s)" << std::setw(12)
+            << "p95(s)" << std::setw(10) << "GFLOP/s" << std::setw(8) << "ci"
+            << "\n";
+  std::cout << std::string(81, '-') << "\n";
+}
+
+inline void print_record(const Record &r) {
+  const Stats &s = r.stats;
+  std::cout << std::setw(12) << r.kernel << std::setw(7) << r.M
+            << std::setw(7) << r.N << std::setw(7) << r.K << std::setw(6)
+            << s.reps << std::setw(12) << std::scientific
+            << std::setprecision(3) << s.median << std::setw(12) << s.p95
+            << std::fixed << std::setw(10) << std::setprecision(2)
+            << gflops(r.M, r.N, r.K, s.median) << std::setw(7)
+            << std::setprecision(1) << 100.0 * s.ci << "%"
+            << "\n";
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+// ================================================================
+// Hardware counters (--counters): derived metrics of one counted call,
+// as record columns ("nan" where the host lacks the event)
+// ================================================================
+inline void add_counter_params(Record &r, const gemm::perf::Counts &c) {
+  const double flops = 2.0 * double(r.M) * double(r.N) * double(r.K);
+
+  auto num = [](double v) {
+    std::ostringstream os;
+    os << std::setprecision(4) << v;
+    return os.str();
+  };
+
+  r.params.push_back({"ipc", num(c.ipc())});
+  r.params.push_back({"l1d_miss_rate", num(c.l1d_miss_rate())});
+  r.params.push_back({"llc_miss_rate", num(c.llc_miss_rate())});
+  r.params.push_back({"dtlb_mpki", num(c.dtlb_mpki())});
+  r.params.push_back({"flops_per_cycle", num(c.flops_per_cycle(flops))});
+}
+
+inline void print_counters(const gemm::perf::Counts &c, double flops) {
+  std::cout << std::fixed << std::setprecision(2) << std::setw(16)
+            << "IPC " << c.ipc() << "  L1D miss " << 100.0 * c.l1d_miss_rate()
+            << "%  LLC miss " << 100.0 * c.llc_miss_rate() << "%  dTLB "
+            << c.dtlb_mpki() << "/ki  FLOP/cycle " << c.flops_per_cycle(flops)
+            << "\n";
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+// Per-phase breakdown of the library-mode counters (ATLAS_PERF_COUNTERS)
+inline void print_phase_counts() {
+  using namespace gemm::perf;
+
+  const auto phases = phase_counts();
+  std::uint64_t total = 0;
+  for (const Counts &c : phases)
+    total += c[Event::Cycles];
+  if (total == 0)
+    return;
+
+  for (std::size_t p = 0; p < NUM_PHASES; ++p) {
+    const Counts &c = phases[p];
+    std::cout << std::fixed << std::setprecision(1) << std::setw(16)
+              << phase_name(Phase(p)) << std::setw(7)
+              << 100.0 * double(c[Event::Cycles]) / double(total)
+              << "% cycles  IPC " << std::setprecision(2) << c.ipc()
+              << "  L1D miss " << 100.0 * c.l1d_miss_rate() << "%  dTLB "
+              << c.dtlb_mpki() << "/ki\n";
+  }
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+// ================================================================
+// Command line: --name value pairs and bare flags
+// ================================================================
+struct Args {
+  std::vector<std::string> argv;
+
+  Args(int argc, char **argv_) : argv(argv_ + 1, argv_ + argc) {}
+
+  bool flag(const std::string &name) const {
+    return std::find(argv.begin(), argv.end(), name) != argv.end();
+  }
+
+  std::string get(const std::string &name, const std::string &def) const {
+    auto it = std::find(argv.begin(), argv.end(), name);
+    return it != argv.end() && it + 1 != argv.end() ? *(it + 1) : def;
+  }
+
+  double get(const std::string &name, double def) const {
+    std::string v = get(name, std::string());
+    return v.empty() ? def : std::stod(v);
+  }
+
+  // Comma-separated list
+  std::vector<std::string> list(const std::string &name) const {
+    std::vector<std::string> out;
+    std::stringstream ss(get(name, std::string()));
+    for (std::string item; std::getline(ss, item, ',');)
+      if (!item.empty())
+        out.push_back(item);
+    return out;
+  }
+
+  // Repetition options shared by every benchmark
+  RunOptions run_options() const {
+    RunOptions o;
+    o.min_reps = std::size_t(get("--min-reps", double(o.min_reps)));
+    o.max_reps = std::size_t(get("--max-reps", double(o.max_reps)));
+    o.max_seconds = get("--max-time", o.max_seconds);
+    o.target_ci = get("--target-ci", o.target_ci);
+    o.flush_cache = flag("--flush");
+    return o;
+  }
+};
+
+inline void fill_matrix(std::vector<float> &x) {
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = float((i * 1315423911u) & 0xFF) / 255.0f;
+}
+
+} // namespace bench
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+"""Compare two benchmark harness JSON files and flag regressions.
+
+    ./benchmark_gemm --min-reps 15 --json base.json        # before
+    ./benchmark_gemm --min-reps 15 --json head.json        # after
+    python3 ci/compare_benchmarks.py base.json head.json
+
+Records are matched on kernel, scenario, M, N, K and the configuration
+params named by --key-params (block sizes, workers, leading dimensions...).
+For every pair the per-repetition times (samples_s) go through a one-sided
+Mann-Whitney U test; a record regresses when the candidate is slower with
+p < --alpha AND its median time grew by more than --threshold. Both are
+needed: the test alone flags 1% shifts on quiet machines, the threshold
+alone flags noise on busy ones.
+
+Exit status: 0 no regression, 1 regression (or missing records with
+--fail-on-missing), 2 unreadable input.
+"""
+
+import argparse
+import json
+import math
+import sys
+from functools import lru_cache
+
+DEFAULT_KEY_PARAMS = "BM,BN,BK,workers,mode,kind,lda,ldb,ldc"
+
+
+# ================================================================
+# Mann-Whitney U
+# ================================================================
+def ranks(values):
+    """1-based ranks, ties get the mean rank. Returns (ranks, tie sizes)."""
+    order = sorted(range(len(values)), key=values.__getitem__)
+    r = [0.0] * len(values)
+    ties = []
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            r[order[k]] = (i + j) / 2.0 + 1.0
+        if j > i:
+            ties.append(j - i + 1)
+        i = j + 1
+    return r, ties
+
+
+@lru_cache(maxsize=None)
+def _arrangements(m, n, u):
+    """Orderings of m x's and n y's with exactly u (x > y) pairs."""
+    if u < 0 or u > m * n:
+        return 0
+    if m == 0 or n == 0:
+        return 1 if u == 0 else 0
+    # Largest element is an x (beats all n y's) or a y (beats nothing)
+    return _arrangements(m - 1, n, u - n) + _arrangements(m, n - 1, u)
+
+
+def mann_whitney_greater(x, y):
+    """One-sided p-value for 'x tends to be larger than y'."""
+    m, n = len(x), len(y)
+    r, ties = ranks(list(x) + list(y))
+    u = sum(r[:m]) - m * (m + 1) / 2.0
+
+    # Exact null distribution for small tie-free samples
+    if not ties and m <= 25 and n <= 25:
+        total = math.comb(m + n, m)
+        tail = sum(_arrangements(m, n, k) for k in range(int(u), m * n + 1))
+        return tail / total
+
+    # Normal approximation, tie-corrected, continuity-corrected
+    N = m + n
+    tie_term = sum(t ** 3 - t for t in ties) / (N * (N - 1))
+    var = m * n / 12.0 * ((N + 1) - tie_term)
+    if var <= 0:
+        return 1.0
+    z = (u - m * n / 2.0 - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+# ================================================================
+# Loading and matching
+# ================================================================
+def load(path, key_params):
+    with open(path) as f:
+        doc = json.load(f)
+
+    records = {}
+    for r in doc.get("results", []):
+        key = (r["kernel"], r["scenario"], r["M"], r["N"], r["K"]) + tuple(
+            f"{p}={r[p]}" if p in r else "" for p in key_params)
+        if key in records:
+            raise KeyError(f"{path}: duplicate record {fmt_key(key)}; "
+                           "add the distinguishing param to --key-params")
+        records[key] = r
+    return doc.get("benchmark", "?"), doc.get("host", {}), records
+
+
+def fmt_key(key):
+    kernel, scenario, M, N, K = key[:5]
+    extra = ",".join(v for v in key[5:] if v)
+    return f"{kernel}/{scenario} {M}x{N}x{K}" + (f" [{extra}]" if extra else "")
+
+
+def samples(r):
+    s = r.get("samples_s") or []
+    return s if s else [r["median_s"]]
+
+
+def compare(base, head, threshold, alpha):
+    rows = []
+    for key in sorted(base.keys() & head.keys()):
+        b, h = base[key], head[key]
+        bs, hs = samples(b), samples(h)
+        delta = h["median_s"] / b["median_s"] - 1.0 if b["median_s"] else 0.0
+
+        if len(bs) >= 3 and len(hs) >= 3:
+            p_slower = mann_whitney_greater(hs, bs)
+            p_faster = mann_whitney_greater(bs, hs)
+        else:
+            # No repetitions stored: only a delta beyond both CIs counts
+            noise = b.get("ci", 0.0) + h.get("ci", 0.0)
+            p_slower = 0.0 if delta > noise else 1.0
+            p_faster = 0.0 if -delta > noise else 1.0
+
+        if delta > threshold and p_slower < alpha:
+            status = "REGRESSION"
+        elif -delta > threshold and p_faster < alpha:
+            status = "improved"
+        else:
+            status = "ok"
+
+        rows.append({
+            "key": fmt_key(key),
+            "base_gflops": b.get("gflops_median", 0.0),
+            "head_gflops": h.get("gflops_median", 0.0),
+            "base_median_s": b["median_s"],
+            "head_median_s": h["median_s"],
+            "delta": delta,
+            "p": p_slower if delta >= 0 else p_faster,
+            "reps": f"{len(bs)}/{len(hs)}",
+            "status": status,
+        })
+    # Worst first
+    rows.sort(key=lambda r: -r["delta"])
+    return rows
+
+
+# ================================================================
+# Output
+# ================================================================
+def print_table(rows):
+    w = max([len(r["key"]) for r in rows] + [6])
+    print(f"{'record':<{w}} {'base GF/s':>10} {'head GF/s':>10} "
+          f"{'time':>8} {'p':>9} {'reps':>7}  status")
+    print("-" * (w + 58))
+    for r in rows:
+        print(f"{r['key']:<{w}} {r['base_gflops']:>10.2f} "
+              f"{r['head_gflops']:>10.2f} {r['delta']:>+7.1%} "
+              f"{r['p']:>9.2e} {r['reps']:>7}  {r['status']}")
+
+
+def write_markdown(path, rows, regressions, missing, args):
+    with open(path, "a") as f:
+        f.write(f"### Benchmark comparison: {len(regressions)} regression(s)\n\n"
+                f"threshold {args.threshold:.0%}, alpha {args.alpha}\n\n"
+                "| record | base GFLOP/s | head GFLOP/s | time | p | status |\n"
+                "|---|---:|---:|---:|---:|---|\n")
+        for r in rows:
+            f.write(f"| {r['key']} | {r['base_gflops']:.2f} | "
+                    f"{r['head_gflops']:.2f} | {r['delta']:+.1%} | "
+                    f"{r['p']:.2e} | {r['status']} |\n")
+        for k in missing:
+            f.write(f"| {fmt_key(k)} | | | | | missing |\n")
+        f.write("\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("baseline", help="harness JSON (--json) of the baseline")
+    ap.add_argument("candidate", help="harness JSON of the change under test")
+    ap.add_argument("--threshold", type=float, default=0.05,
+                    help="minimum median slowdown to fail (default 0.05)")
+    ap.add_argument("--alpha", type=float, default=0.01,
+                    help="significance level of the U test (default 0.01)")
+    ap.add_argument("--key-params", default=DEFAULT_KEY_PARAMS,
+                    help="params that identify a record besides "
+                         "kernel/scenario/M/N/K")
+    ap.add_argument("--fail-on-missing", action="store_true",
+                    help="fail when a baseline record has no candidate")
+    ap.add_argument("--json", help="write the comparison rows here")
+    ap.add_argument("--markdown",
+                    help="append a table (e.g. $GITHUB_STEP_SUMMARY)")
+    args = ap.parse_args()
+
+    key_params = [p for p in args.key_params.split(",") if p]
+    try:
+        b_name, b_host, base = load(args.baseline, key_params)
+        h_name, h_host, head = load(args.candidate, key_params)
+    except (OSError, ValueError, KeyError, TypeError) as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 2
+
+    if b_name != h_name:
+        print(f"warning: comparing {b_name} against {h_name}", file=sys.stderr)
+    if b_host.get("cpu") != h_host.get("cpu"):
+        print(f"warning: different CPUs ({b_host.get('cpu')} vs "
+              f"{h_host.get('cpu')}); deltas include the machine",
+              file=sys.stderr)
+
+    rows = compare(base, head, args.threshold, args.alpha)
+    missing = sorted(base.keys() - head.keys())
+    added = sorted(head.keys() - base.keys())
+
+    if rows:
+        print_table(rows)
+    for k in missing:
+        print(f"missing in candidate: {fmt_key(k)}")
+    for k in added:
+        print(f"new in candidate:     {fmt_key(k)}")
+
+    regressions = [r for r in rows if r["status"] == "REGRESSION"]
+    improved = sum(r["status"] == "improved" for r in rows)
+    print(f"\n{len(rows)} compared, {len(regressions)} regressed, "
+          f"{improved} improved, {len(missing)} missing "
+          f"(threshold {args.threshold:.0%}, alpha {args.alpha})")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"rows": rows,
+                       "missing": [fmt_key(k) for k in missing]}, f, indent=2)
+    if args.markdown:
+        write_markdown(args.markdown, rows, regressions, missing, args)
+
+    if regressions or (args.fail_on_missing and missing):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,92 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "fused_gemm.hpp"
+#include "kernel_config.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// ================================================================
+// Row panel height: the hidden panel (rows x N1 floats) should stay in
+// this thread's share of L2 while the second GEMM streams over it, and
+// there should be at least one panel per thread.
+// ================================================================
+static index_t panel_rows(const ChainedGemmConfig &cfg, unsigned threads) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t MR = config::MR;
+
+  // Half of the per-thread L2 share: the rest holds the packed W blocks
+  index_t budget = config::L2_BYTES / (2 * threads);
+  index_t rows = budget / (std::max<index_t>(cfg.N1, 1) * sizeof(float));
+
+  index_t per_thread = (cfg.M + threads - 1) / threads;
+  per_thread = (per_thread + MR - 1) / MR * MR;
+
+  rows = std::min({rows / MR * MR, BM, per_thread});
+  return std::max(rows, MR);
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_chained(const float *X, const float *W1, const float *W2, float *Y,
+                  const ChainedGemmConfig &cfg, const FusedEpilogue &ep1,
+                  const FusedEpilogue &ep2) {
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  if (cfg.M == 0 || cfg.N2 == 0)
+    return;
+
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  index_t P = panel_rows(cfg, num_threads);
+  index_t panels = (cfg.M + P - 1) / P;
+
+  index_t hidden_bytes = P * cfg.N1 * sizeof(float);
+
+  detail::with_epilogue(ep1, [&](const auto &hidden_ep) {
+    detail::with_epilogue(ep2, [&](const auto &out_ep) {
+      detail::parallel_tiles(
+          panels,
+          [&](Workspace &ws, index_t panel) {
+            index_t ii = panel * P;
+            index_t Pm = std::min(P, cfg.M - ii);
+
+            float *H = ws.scratch();
+
+            // H = ep1(X[ii:ii+Pm, :] * W1), row panel kept in scratch.
+            // Epilogue rows are panel-local, so re-base the residuals.
+            GemmConfig first{Pm, cfg.N1, cfg.K, cfg.ldx, cfg.ldw1, cfg.N1};
+            auto hidden_panel_ep = epilogue::offset_rows(hidden_ep, ii);
+
+            for (index_t jj = 0; jj < cfg.N1; jj += BN) {
+              index_t Nb = std::min(BN, cfg.N1 - jj);
+              detail::compute_block(ws, X + ii * cfg.ldx, W1, H, first, 0, jj,
+                                    Pm, Nb, hidden_panel_ep, false);
+            }
+
+            // Y[ii:ii+Pm, :] = ep2(H * W2) while H is still hot in L2
+            GemmConfig second{Pm, cfg.N2, cfg.N1, cfg.N1, cfg.ldw2, cfg.ldy};
+
+            auto panel_ep = epilogue::offset_rows(out_ep, ii);
+
+            for (index_t jj = 0; jj < cfg.N2; jj += BN) {
+              index_t Nb = std::min(BN, cfg.N2 - jj);
+              detail::compute_block(ws, H, W2, Y + ii * cfg.ldy, second, 0, jj,
+                                    Pm, Nb, panel_ep, false);
+            }
+          },
+          hidden_bytes);
+    });
+  });
+}
+
+} // namespace gemm
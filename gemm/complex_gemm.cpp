@@ -0,0 +1,114 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <complex>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// ================================================================
+// One BM x BN block of C += A * B as real GEMMs on split operands.
+// The real / imaginary splitting happens in pack_A / pack_B, so each
+// product runs the ordinary real microkernel; S1 and S2 are real
+// Mb x Nb partial products in the workspace scratch.
+//
+//   4M: re = Ar Br + (-Ai) Bi            im = Ar Bi + Ai Br
+//   3M: P1 = Ar Br, P2 = Ai Bi, P3 = (Ar + Ai)(Br + Bi)
+//       re = P1 - P2                     im = P3 - P1 - P2
+// ================================================================
+template <class T>
+static void complex_block(BasicWorkspace<T> &ws, const std::complex<T> *A,
+                          const std::complex<T> *B, std::complex<T> *C,
+                          const GemmConfig &cfg, ComplexMethod method,
+                          index_t ii, index_t jj, index_t Mb, index_t Nb) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  T *S1 = ws.scratch();
+  T *S2 = S1 + BM * BN;
+
+  // Block-local problem: products land in S1 / S2 with ld = Nb
+  GemmConfig local{Mb, Nb, cfg.K, cfg.lda, cfg.ldb, Nb};
+  const std::complex<T> *Ab = A + ii * cfg.lda;
+  const std::complex<T> *Bb = B + jj;
+
+  auto product = [&](T *S, ComplexPart pa, ComplexPart pb, bool accumulate) {
+    detail::ComplexOperand<T> a{Ab, pa}, b{Bb, pb};
+    detail::compute_block(ws, &a, &b, S, local, 0, 0, Mb, Nb,
+                          epilogue::Identity{}, accumulate);
+  };
+
+  auto c_at = [&](index_t i, index_t j) -> std::complex<T> & {
+    return C[(ii + i) * cfg.ldc + jj + j];
+  };
+
+  if (method == ComplexMethod::FourM) {
+    product(S1, ComplexPart::Real, ComplexPart::Real, false);
+    product(S1, ComplexPart::NegImag, ComplexPart::Imag, true);
+    product(S2, ComplexPart::Real, ComplexPart::Imag, false);
+    product(S2, ComplexPart::Imag, ComplexPart::Real, true);
+
+    for (index_t i = 0; i < Mb; ++i)
+      for (index_t j = 0; j < Nb; ++j)
+        c_at(i, j) += std::complex<T>(S1[i * Nb + j], S2[i * Nb + j]);
+    return;
+  }
+
+  product(S1, ComplexPart::Real, ComplexPart::Real, false);
+  product(S2, ComplexPart::Imag, ComplexPart::Imag, false);
+
+  // re += P1 - P2, keep P1 + P2 for the imaginary part
+  for (index_t i = 0; i < Mb; ++i)
+    for (index_t j = 0; j < Nb; ++j) {
+      T p1 = S1[i * Nb + j], p2 = S2[i * Nb + j];
+      std::complex<T> &c = c_at(i, j);
+      c.real(c.real() + (p1 - p2));
+      S1[i * Nb + j] = p1 + p2;
+    }
+
+  product(S2, ComplexPart::Sum, ComplexPart::Sum, false);
+
+  for (index_t i = 0; i < Mb; ++i)
+    for (index_t j = 0; j < Nb; ++j) {
+      std::complex<T> &c = c_at(i, j);
+      c.imag(c.imag() + (S2[i * Nb + j] - S1[i * Nb + j]));
+    }
+}
+
+template <class T>
+static void gemm_complex_impl(const std::complex<T> *A,
+                              const std::complex<T> *B, std::complex<T> *C,
+                              const GemmConfig &cfg, ComplexMethod method) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  detail::parallel_blocks<T>(
+      cfg.M, cfg.N,
+      [&](BasicWorkspace<T> &ws, index_t ii, index_t jj, index_t Mb,
+          index_t Nb) {
+        complex_block(ws, A, B, C, cfg, method, ii, jj, Mb, Nb);
+      },
+      2 * BM * BN * sizeof(T));
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_complex(const std::complex<float> *A, const std::complex<float> *B,
+                  std::complex<float> *C, const GemmConfig &cfg,
+                  ComplexMethod method) {
+  gemm_complex_impl(A, B, C, cfg, method);
+}
+
+void gemm_complex(const std::complex<double> *A,
+                  const std::complex<double> *B, std::complex<double> *C,
+                  const GemmConfig &cfg, ComplexMethod method) {
+  gemm_complex_impl(A, B, C, cfg, method);
+}
+
+} // namespace gemm
@@ -0,0 +1,92 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// ================================================================
+// NHWC: one GEMM over the whole batch,
+//   output (batch * OH * OW x OC) = patches (x K) * weights (K x OC)
+// with the patch rows gathered by the A packer.
+// ================================================================
+static void conv2d_nhwc(const float *input, const float *weights,
+                        float *output, const ConvShape &s) {
+  const index_t P = index_t(s.batch) * s.out_height() * s.out_width();
+  const index_t OC = s.out_channels;
+  const index_t K = s.patch_size();
+
+  GemmConfig g{P, OC, K, K, OC, OC};
+  detail::ConvOperand patches{input, s};
+
+  detail::parallel_blocks(
+      P, OC, [&](Workspace &ws, index_t ii, index_t jj, index_t Mb,
+                 index_t Nb) {
+        detail::compute_block(ws, &patches, weights, output, g, ii, jj, Mb, Nb,
+                              epilogue::Identity{}, false);
+      });
+}
+
+// ================================================================
+// NCHW: one GEMM per image,
+//   output_n (OC x OH * OW) = weights (OC x K) * patches_n (K x OH * OW)
+// with the patch columns gathered by the B packer. The tiles of every
+// image share one scheduler.
+// ================================================================
+static void conv2d_nchw(const float *input, const float *weights,
+                        float *output, const ConvShape &s) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  const index_t P = index_t(s.out_height()) * s.out_width();
+  const index_t OC = s.out_channels;
+  const index_t K = s.patch_size();
+  const index_t image = index_t(s.channels) * s.height * s.width;
+
+  GemmConfig g{OC, P, K, K, P, P};
+
+  index_t tiles_m = (OC + BM - 1) / BM;
+  index_t tiles_n = (P + BN - 1) / BN;
+  index_t per_image = tiles_m * tiles_n;
+
+  detail::parallel_tiles(
+      s.batch * per_image, [&](Workspace &ws, index_t tile_id) {
+        index_t n = tile_id / per_image;
+        index_t t = tile_id % per_image;
+
+        index_t ii = (t / tiles_n) * BM;
+        index_t jj = (t % tiles_n) * BN;
+
+        detail::ConvOperand patches{input + n * image, s};
+
+        detail::compute_block(ws, weights, &patches, output + n * OC * P, g,
+                              ii, jj, std::min(BM, OC - ii),
+                              std::min(BN, P - jj), epilogue::Identity{},
+                              false);
+      });
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_conv2d(const float *input, const float *weights, float *output,
+                 const ConvShape &shape) {
+  if (shape.batch <= 0 || shape.out_channels <= 0 || shape.kernel_h < 1 ||
+      shape.kernel_w < 1 || shape.stride_h < 1 || shape.stride_w < 1 ||
+      shape.dilation_h < 1 || shape.dilation_w < 1 || shape.pad_h < 0 ||
+      shape.pad_w < 0 || shape.out_height() <= 0 || shape.out_width() <= 0)
+    return;
+
+  if (shape.layout == ConvLayout::NHWC)
+    conv2d_nhwc(input, weights, output, shape);
+  else
+    conv2d_nchw(input, weights, output, shape);
+}
+
+} // namespace gemm
@@ -0,0 +1,43 @@
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "shape_trace.hpp"
+
+#include <thread>
+
+namespace gemm {
+
+// Widest M / N that the streaming kernels handle better than packing
+static constexpr index_t SKINNY_MAX = 4;
+
+// ================================================================
+// Shape-based routing. Skinny N goes first: it reads A (the large
+// operand) exactly once even when M is also small.
+// ================================================================
+GemmPath gemm_select_path(const GemmConfig &cfg) {
+  if (cfg.N <= SKINNY_MAX)
+    return GemmPath::SkinnyN;
+  if (cfg.M <= SKINNY_MAX)
+    return GemmPath::SkinnyM;
+  return GemmPath::Packed;
+}
+
+void gemm_dispatch(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg) {
+  shape_trace::Scope record(shape_trace::Entry::Dispatch,
+                            shape_trace::DType::F32, cfg,
+                            std::thread::hardware_concurrency());
+
+  switch (gemm_select_path(cfg)) {
+  case GemmPath::SkinnyN:
+    gemm_skinny_n(A, B, C, cfg);
+    break;
+  case GemmPath::SkinnyM:
+    gemm_skinny_m(A, B, C, cfg);
+    break;
+  case GemmPath::Packed:
+    gemm_v6_parallel(A, B, C, cfg);
+    break;
+  }
+}
+
+} // namespace gemm
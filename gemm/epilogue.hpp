@@ -0,0 +1,194 @@
+#pragma once
+#include "kernel_config.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <cmath>
+#include <tuple>
+
+// Compile-time epilogues applied to the C tile while it is still in
+// registers (last K slice of the packed drivers).
+//
+// Every functor provides a vector form (4 consecutive columns of one row)
+// and a scalar form (edge tiles). row/col are global C coordinates.
+
+namespace gemm::epilogue {
+
+namespace detail {
+
+// exp(x) for 4 lanes: range reduction to [-ln2/2, ln2/2] + degree-6 poly
+static inline float32x4_t exp_f32x4(float32x4_t x) {
+  x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(-87.3f)), vdupq_n_f32(88.3f));
+
+  float32x4_t n = vrndnq_f32(vmulq_f32(x, vdupq_n_f32(1.44269504f)));
+  float32x4_t r = vfmsq_f32(x, n, vdupq_n_f32(0.693359375f));
+  r = vfmsq_f32(r, n, vdupq_n_f32(-2.12194440e-4f));
+
+  float32x4_t p = vdupq_n_f32(1.0f / 720.0f);
+  p = vfmaq_f32(vdupq_n_f32(1.0f / 120.0f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(1.0f / 24.0f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(1.0f / 6.0f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(0.5f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(1.0f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(1.0f), p, r);
+
+  // 2^n through the exponent field
+  int32x4_t e = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+  return vmulq_f32(p, vreinterpretq_f32_s32(e));
+}
+
+// 1 / (1 + exp(-x))
+static inline float32x4_t sigmoid_f32x4(float32x4_t x) {
+  float32x4_t one = vdupq_n_f32(1.0f);
+  return vdivq_f32(one, vaddq_f32(one, exp_f32x4(vnegq_f32(x))));
+}
+
+static inline float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+constexpr float GELU_K0 = 0.7978845608f; // sqrt(2 / pi)
+constexpr float GELU_K1 = 0.044715f;
+
+} // namespace detail
+
+// ================================================================
+// Elementwise operations
+// ================================================================
+
+// Any scalar / vector type (also the fp64 DGEMM kernels)
+struct Identity {
+  template <class V> V operator()(V v, index_t, index_t) const { return v; }
+};
+
+// v * alpha
+struct Scale {
+  float alpha;
+
+  float32x4_t operator()(float32x4_t v, index_t, index_t) const {
+    return vmulq_n_f32(v, alpha);
+  }
+  float operator()(float v, index_t, index_t) const { return v * alpha; }
+};
+
+// v + bias[row]
+struct BiasRow {
+  const float *bias;
+
+  float32x4_t operator()(float32x4_t v, index_t row, index_t) const {
+    return vaddq_f32(v, vdupq_n_f32(bias[row]));
+  }
+  float operator()(float v, index_t row, index_t) const {
+    return v + bias[row];
+  }
+};
+
+// v + bias[col]
+struct BiasCol {
+  const float *bias;
+
+  float32x4_t operator()(float32x4_t v, index_t, index_t col) const {
+    return vaddq_f32(v, vld1q_f32(bias + col));
+  }
+  float operator()(float v, index_t, index_t col) const {
+    return v + bias[col];
+  }
+};
+
+struct Relu {
+  float32x4_t operator()(float32x4_t v, index_t, index_t) const {
+    return vmaxq_f32(v, vdupq_n_f32(0.0f));
+  }
+  float operator()(float v, index_t, index_t) const {
+    return std::max(v, 0.0f);
+  }
+};
+
+// tanh approximation: 0.5 x (1 + tanh(k0 (x + k1 x^3)))
+//                   = x * sigmoid(2 k0 (x + k1 x^3))
+struct Gelu {
+  float32x4_t operator()(float32x4_t v, index_t, index_t) const {
+    float32x4_t x3 = vmulq_f32(vmulq_f32(v, v), v);
+    float32x4_t u = vfmaq_n_f32(v, x3, detail::GELU_K1);
+    return vmulq_f32(v, detail::sigmoid_f32x4(
+                            vmulq_n_f32(u, 2.0f * detail::GELU_K0)));
+  }
+  float operator()(float v, index_t, index_t) const {
+    float u = v + detail::GELU_K1 * v * v * v;
+    return v * detail::sigmoid(2.0f * detail::GELU_K0 * u);
+  }
+};
+
+// x * sigmoid(x)
+struct Silu {
+  float32x4_t operator()(float32x4_t v, index_t, index_t) const {
+    return vmulq_f32(v, detail::sigmoid_f32x4(v));
+  }
+  float operator()(float v, index_t, index_t) const {
+    return v * detail::sigmoid(v);
+  }
+};
+
+// min(max(v, lo), hi)
+struct Clamp {
+  float lo;
+  float hi;
+
+  float32x4_t operator()(float32x4_t v, index_t, index_t) const {
+    return vminq_f32(vmaxq_f32(v, vdupq_n_f32(lo)), vdupq_n_f32(hi));
+  }
+  float operator()(float v, index_t, index_t) const {
+    return std::min(std::max(v, lo), hi);
+  }
+};
+
+// v + R[row, col] (residual connection)
+struct AddMatrix {
+  const float *R;
+  index_t ldr;
+
+  float32x4_t operator()(float32x4_t v, index_t row, index_t col) const {
+    return vaddq_f32(v, vld1q_f32(R + row * ldr + col));
+  }
+  float operator()(float v, index_t row, index_t col) const {
+    return v + R[row * ldr + col];
+  }
+};
+
+// ================================================================
+// Composition: ops applied left to right
+// ================================================================
+template <class... Ops> struct Chain {
+  std::tuple<Ops...> ops;
+
+  template <class V> V operator()(V v, index_t row, index_t col) const {
+    std::apply([&](const Ops &...op) { ((v = op(v, row, col)), ...); }, ops);
+    return v;
+  }
+};
+
+template <class... Ops> Chain<Ops...> chain(Ops... ops) {
+  return Chain<Ops...>{std::tuple<Ops...>(ops...)};
+}
+
+// ================================================================
+// Row re-basing: the same epilogue applied to a sub-matrix whose row 0
+// is row `rows` of the original C (drivers working on row panels).
+// ================================================================
+template <class Op> Op offset_rows(Op op, index_t) { return op; }
+
+inline BiasRow offset_rows(BiasRow op, index_t rows) {
+  op.bias += rows;
+  return op;
+}
+
+inline AddMatrix offset_rows(AddMatrix op, index_t rows) {
+  op.R += rows * op.ldr;
+  return op;
+}
+
+template <class... Ops>
+Chain<Ops...> offset_rows(const Chain<Ops...> &c, index_t rows) {
+  return std::apply(
+      [&](const Ops &...op) { return chain(offset_rows(op, rows)...); }, c.ops);
+}
+
+} // namespace gemm::epilogue
@@ -0,0 +1,16 @@
+#include "fused_gemm.hpp"
+#include "kernel_config.hpp"
+
+namespace gemm {
+
+// ================================================================
+// Public API: C = act(alpha * A * B + bias) + residual
+// ================================================================
+void gemm_fused(const float *A, const float *B, float *C,
+                const GemmConfig &cfg, const FusedEpilogue &ep) {
+  detail::with_epilogue(ep, [&](const auto &chain) {
+    gemm_fused(A, B, C, cfg, chain);
+  });
+}
+
+} // namespace gemm
@@ -0,0 +1,66 @@
+#pragma once
+#include "epilogue.hpp"
+#include "kernel_config.hpp"
+#include "packed_block.hpp"
+
+namespace gemm {
+
+namespace detail {
+
+// Maps a runtime FusedEpilogue onto its compile-time chain and calls
+// f(chain). One switch per call, none per element.
+template <class F> void with_epilogue(const FusedEpilogue &ep, const F &f) {
+  using namespace epilogue;
+
+  auto dispatch = [&](auto act) {
+    Scale scale{ep.alpha};
+
+    if (ep.bias && ep.residual)
+      f(chain(scale, BiasCol{ep.bias}, act, AddMatrix{ep.residual, ep.ldr}));
+    else if (ep.bias)
+      f(chain(scale, BiasCol{ep.bias}, act));
+    else if (ep.residual)
+      f(chain(scale, act, AddMatrix{ep.residual, ep.ldr}));
+    else
+      f(chain(scale, act));
+  };
+
+  switch (ep.activation) {
+  case Activation::None:
+    dispatch(Identity{});
+    break;
+  case Activation::Relu:
+    dispatch(Relu{});
+    break;
+  case Activation::Gelu:
+    dispatch(Gelu{});
+    break;
+  case Activation::Silu:
+    dispatch(Silu{});
+    break;
+  }
+}
+
+} // namespace detail
+
+// ================================================================
+// C = ep(A * B) — parallel packed GEMM (v6 scheduling) whose microkernel
+// applies `ep` to the tile before its final store. Compose operations
+// with epilogue::chain(...), e.g.
+//
+//   gemm_fused(A, B, C, cfg,
+//              epilogue::chain(epilogue::BiasCol{b}, epilogue::Gelu{},
+//                              epilogue::AddMatrix{R, ldr}));
+// ================================================================
+template <class Epilogue>
+void gemm_fused(const float *A, const float *B, float *C,
+                const GemmConfig &cfg, const Epilogue &ep) {
+  detail::parallel_blocks(cfg.M, cfg.N,
+                          [&](atlas_memory::Workspace &ws, index_t ii,
+                              index_t jj, index_t Mb, index_t Nb) {
+                            detail::compute_block(ws, A, B, C, cfg, ii, jj,
+                                                  Mb, Nb, ep, false);
+                          });
+}
+
+} // namespace gemm
@@ -0,0 +1,92 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// One C block of one problem
+struct GroupedTile {
+  index_t problem;
+  index_t ii, jj;
+  index_t Mb, Nb;
+  index_t cost;
+};
+
+// ================================================================
+// Tile pool: every problem's blocks, heaviest first
+// ================================================================
+static std::vector<GroupedTile> build_pool(const GemmProblem *problems,
+                                           index_t count, index_t tile_m) {
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  std::vector<GroupedTile> pool;
+
+  for (index_t p = 0; p < count; ++p) {
+    const GemmConfig &cfg = problems[p].cfg;
+
+    // Empty experts (M == 0) and K == 0 contribute nothing to C
+    if (cfg.M == 0 || cfg.N == 0 || cfg.K == 0)
+      continue;
+
+    for (index_t ii = 0; ii < cfg.M; ii += tile_m) {
+      for (index_t jj = 0; jj < cfg.N; jj += BN) {
+
+        index_t Mb = std::min(tile_m, cfg.M - ii);
+        index_t Nb = std::min(BN, cfg.N - jj);
+
+        // FMAs of the block plus the A/B panels it has to pack
+        index_t cost = Mb * Nb * cfg.K + (Mb + Nb) * cfg.K;
+
+        pool.push_back({p, ii, jj, Mb, Nb, cost});
+      }
+    }
+  }
+
+  // Longest-processing-time first: big tiles are claimed early so the
+  // small ones fill the gaps at the end of the parallel region.
+  std::stable_sort(pool.begin(), pool.end(),
+                   [](const GroupedTile &a, const GroupedTile &b) {
+                     return a.cost > b.cost;
+                   });
+
+  return pool;
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_grouped(const GemmProblem *problems, index_t count) {
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t MR = config::MR;
+
+  // Shrink the row grain until the pool has enough tiles to keep every
+  // core busy (groups of small experts would otherwise leave cores idle).
+  index_t tile_m = BM;
+  std::vector<GroupedTile> pool = build_pool(problems, count, tile_m);
+
+  while (pool.size() < 4 * index_t(num_threads) && tile_m > 4 * MR) {
+    tile_m /= 2;
+    pool = build_pool(problems, count, tile_m);
+  }
+
+  detail::parallel_tiles(pool.size(), [&](Workspace &ws, index_t tile_id) {
+    const GroupedTile &t = pool[tile_id];
+    const GemmProblem &p = problems[t.problem];
+
+    detail::compute_block(ws, p.A, p.B, p.C, p.cfg, t.ii, t.jj, t.Mb, t.Nb);
+  });
+}
+
+} // namespace gemm
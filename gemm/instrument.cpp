@@ -0,0 +1,125 @@
+#include "instrument.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace gemm::instrument {
+
+double CallStats::imbalance() const {
+  if (workers.empty())
+    return 1.0;
+
+  std::uint64_t sum = 0, max = 0;
+  for (const WorkerStats &w : workers) {
+    sum += w.busy_ticks;
+    max = std::max(max, w.busy_ticks);
+  }
+  return sum ? double(max) * double(workers.size()) / double(sum) : 1.0;
+}
+
+double CallStats::idle_fraction() const {
+  if (workers.empty() || wall_ticks == 0)
+    return 0.0;
+
+  std::uint64_t busy = 0;
+  for (const WorkerStats &w : workers)
+    busy += w.busy_ticks;
+  return 1.0 - double(busy) / (double(workers.size()) * double(wall_ticks));
+}
+
+// ================================================================
+// Process-wide state: callback and totals (one lock per call)
+// ================================================================
+namespace {
+
+struct Registry {
+  std::mutex lock;
+  std::function<void(const CallStats &)> callback;
+  Totals totals;
+};
+
+Registry &registry() {
+  static Registry r;
+  return r;
+}
+
+thread_local CallStats last;
+
+} // namespace
+
+void set_callback(std::function<void(const CallStats &)> cb) {
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.lock);
+  r.callback = std::move(cb);
+}
+
+CallStats last_call() { return last; }
+
+Totals totals() {
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.lock);
+  return r.totals;
+}
+
+void reset_totals() {
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.lock);
+  r.totals = Totals{};
+}
+
+#ifdef ATLAS_INSTRUMENT
+
+// ================================================================
+// CallRecorder
+// ================================================================
+CallRecorder::CallRecorder(unsigned workers)
+    : start_(ticks()), phase_begin_(workers), done_(workers, 0) {
+  stats_.workers.resize(workers);
+}
+
+void CallRecorder::worker_begin(unsigned id) {
+  stats_.workers[id].start_ticks = ticks() - start_;
+  phase_begin_[id] = thread_phase_ticks();
+}
+
+void CallRecorder::worker_end(unsigned id) {
+  const auto &now = thread_phase_ticks();
+  for (std::size_t p = 0; p < NUM_PHASES; ++p)
+    stats_.workers[id].phase_ticks[p] = now[p] - phase_begin_[id][p];
+  done_[id] = ticks();
+}
+
+void CallRecorder::finish() {
+  const std::uint64_t end = ticks();
+  stats_.wall_ticks = end - start_;
+  for (std::size_t w = 0; w < stats_.workers.size(); ++w)
+    stats_.workers[w].idle_ticks = done_[w] ? end - done_[w] : 0;
+
+  std::function<void(const CallStats &)> cb;
+  {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> g(r.lock);
+
+    Totals &t = r.totals;
+    ++t.calls;
+    t.wall_ticks += stats_.wall_ticks;
+    t.worker_slots += stats_.workers.size();
+    for (const WorkerStats &w : stats_.workers) {
+      for (std::size_t p = 0; p < NUM_PHASES; ++p)
+        t.phase_ticks[p] += w.phase_ticks[p];
+      t.busy_ticks += w.busy_ticks;
+      t.start_ticks += w.start_ticks;
+      t.idle_ticks += w.idle_ticks;
+      t.tiles += w.tiles;
+    }
+    cb = r.callback;
+  }
+
+  last = stats_;
+  if (cb)
+    cb(last);
+}
+
+#endif
+
+} // namespace gemm::instrument
@@ -0,0 +1,152 @@
+#pragma once
+#include "perf_counters.hpp"
+#include "ticks.hpp"
+#include "trace.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Per-phase timing and load-balance instrumentation of the GEMM drivers
+// (-DATLAS_INSTRUMENT). Every parallel call (parallel_tiles: v6 and the
+// drivers built on it; v5 as one worker) records, per worker thread,
+// the ticks spent in each phase (pack A, pack B, microkernel, edge
+// tiles), the tiles processed, the start delay and the idle time waiting
+// at the join. The record is handed to a callback, kept as the calling
+// thread's last_call(), and summed into process-wide totals.
+//
+// Times are in ticks (ticks.hpp); ticks_per_second() converts.
+//
+// Without ATLAS_INSTRUMENT the query functions return empty records and
+// the hooks in the drivers compile to nothing.
+
+namespace gemm::instrument {
+
+using perf::NUM_PHASES;
+using perf::Phase;
+
+using gemm::ticks;
+using gemm::ticks_per_second;
+
+struct WorkerStats {
+  std::array<std::uint64_t, NUM_PHASES> phase_ticks{};
+  std::uint64_t busy_ticks = 0;  // inside tiles (phases + C conversion etc.)
+  std::uint64_t start_ticks = 0; // call start -> first instruction of worker
+  std::uint64_t idle_ticks = 0;  // last tile done -> all workers joined
+  std::uint64_t tiles = 0;
+};
+
+struct CallStats {
+  std::uint64_t wall_ticks = 0;
+  std::vector<WorkerStats> workers;
+
+  // max / mean busy ticks over the workers (1: perfectly balanced)
+  double imbalance() const;
+  // Fraction of workers x wall spent outside tiles
+  double idle_fraction() const;
+};
+
+// Process-wide sums since the last reset
+struct Totals {
+  std::uint64_t calls = 0;
+  std::uint64_t wall_ticks = 0;
+  std::array<std::uint64_t, NUM_PHASES> phase_ticks{};
+  std::uint64_t busy_ticks = 0;
+  std::uint64_t start_ticks = 0;
+  std::uint64_t idle_ticks = 0;
+  std::uint64_t tiles = 0;
+  std::uint64_t worker_slots = 0; // sum of worker counts (idle fraction)
+};
+
+// Called on the calling thread after every instrumented call; empty
+// function: none. Keep it cheap, it runs inside the GEMM call.
+void set_callback(std::function<void(const CallStats &)> cb);
+
+CallStats last_call(); // of the calling thread
+Totals totals();
+void reset_totals();
+
+#ifdef ATLAS_INSTRUMENT
+
+// Ticks of the calling thread per phase, running sum over its lifetime
+inline std::array<std::uint64_t, NUM_PHASES> &thread_phase_ticks() {
+  thread_local std::array<std::uint64_t, NUM_PHASES> acc{};
+  return acc;
+}
+
+// Ticks of one phase into the thread's running sum
+class PhaseTimer {
+public:
+  explicit PhaseTimer(Phase p) : phase_(p), start_(ticks()) {}
+  ~PhaseTimer() {
+    thread_phase_ticks()[std::size_t(phase_)] += ticks() - start_;
+  }
+
+  PhaseTimer(const PhaseTimer &) = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+  Phase phase_;
+  std::uint64_t start_;
+};
+
+// One instrumented call: workers report into their own slot, finish()
+// (on the calling thread, after the join) publishes the record
+class CallRecorder {
+public:
+  explicit CallRecorder(unsigned workers);
+
+  void worker_begin(unsigned id);
+  void worker_end(unsigned id);
+  void finish();
+
+  // Busy time and count of one tile
+  class Tile {
+  public:
+    Tile(CallRecorder &rec, unsigned id) : w_(rec.stats_.workers[id]) {
+      start_ = ticks();
+    }
+    ~Tile() {
+      w_.busy_ticks += ticks() - start_;
+      ++w_.tiles;
+    }
+
+    Tile(const Tile &) = delete;
+    Tile &operator=(const Tile &) = delete;
+
+  private:
+    WorkerStats &w_;
+    std::uint64_t start_;
+  };
+
+private:
+  CallStats stats_;
+  std::uint64_t start_;
+  std::vector<std::array<std::uint64_t, NUM_PHASES>> phase_begin_;
+  std::vector<std::uint64_t> done_;
+};
+
+#else
+
+class PhaseTimer {
+public:
+  explicit PhaseTimer(Phase) {}
+};
+
+#endif
+
+// Phase hook of compute_block: ticks (ATLAS_INSTRUMENT), perf counters
+// (ATLAS_PERF_COUNTERS) and a trace span (ATLAS_TRACE) of the enclosed
+// work; an empty object when none is enabled
+class PhaseScope {
+public:
+  explicit PhaseScope(Phase p) : counters_(p), span_(p), timer_(p) {}
+
+private:
+  [[no_unique_address]] perf::PhaseScope counters_;
+  [[no_unique_address]] trace::Span span_;
+  [[no_unique_address]] PhaseTimer timer_;
+};
+
+} // namespace gemm::instrument
@@ -0,0 +1,286 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <cstdint>
+#include <type_traits>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+static constexpr index_t KGROUP = 4;
+
+// ================================================================
+// 8x8 s8 x s8 -> s32 microkernel over KGROUP-interleaved panels
+// (A re-biased to s8 by pack_A_u8; see the correction in finish_tile)
+// ================================================================
+static inline void microkernel_s8_8x8(const std::int8_t *A,
+                                      const std::int8_t *B, index_t Kp,
+                                      int32x4_t c[8][2]) {
+  constexpr index_t MR = config::MR;
+  constexpr index_t NR = config::NR;
+
+#if defined(__ARM_FEATURE_DOTPROD)
+  // sdot: 4 columns x 4 k per register, one A row per lane
+  for (index_t k = 0; k < Kp; k += KGROUP) {
+    int8x16_t b0 = vld1q_s8(B + k * NR);
+    int8x16_t b1 = vld1q_s8(B + k * NR + 16);
+    int8x16_t a0 = vld1q_s8(A + k * MR);
+    int8x16_t a1 = vld1q_s8(A + k * MR + 16);
+
+#define ATLAS_SDOT_ROW(i, a, lane)                                             \
+  c[i][0] = vdotq_laneq_s32(c[i][0], b0, a, lane);                             \
+  c[i][1] = vdotq_laneq_s32(c[i][1], b1, a, lane);
+
+    ATLAS_SDOT_ROW(0, a0, 0)
+    ATLAS_SDOT_ROW(1, a0, 1)
+    ATLAS_SDOT_ROW(2, a0, 2)
+    ATLAS_SDOT_ROW(3, a0, 3)
+    ATLAS_SDOT_ROW(4, a1, 0)
+    ATLAS_SDOT_ROW(5, a1, 1)
+    ATLAS_SDOT_ROW(6, a1, 2)
+    ATLAS_SDOT_ROW(7, a1, 3)
+
+#undef ATLAS_SDOT_ROW
+  }
+#else
+  // Widening multiply-accumulate (smlal): vld4 de-interleaves the
+  // KGROUP layout into one 8-column vector per k
+  for (index_t k = 0; k < Kp; k += KGROUP) {
+    int8x8x4_t b = vld4_s8(B + k * NR);
+    const std::int8_t *a = A + k * MR;
+
+    for (index_t kk = 0; kk < KGROUP; ++kk) {
+      int16x8_t bk = vmovl_s8(b.val[kk]);
+      int16x4_t lo = vget_low_s16(bk);
+      int16x4_t hi = vget_high_s16(bk);
+
+      for (index_t i = 0; i < MR; ++i) {
+        std::int16_t ai = a[i * KGROUP + kk];
+        c[i][0] = vmlal_n_s16(c[i][0], lo, ai);
+        c[i][1] = vmlal_n_s16(c[i][1], hi, ai);
+      }
+    }
+  }
+#endif
+}
+
+// ================================================================
+// Per-block column terms of the zero-point correction and requant
+//
+//   sum_k (a - za)(b - zb_j)
+//     = raw + (128 - za) * colsum_j + K * za * zb_j - zb_j * rowsum_i
+//
+// raw is the s8 x s8 product of the re-biased A (a - 128), rowsum the
+// u8 row sums of A, colsum the s8 column sums of B.
+// ================================================================
+struct BlockTerms {
+  std::int32_t *col_term; // (128 - za) * colsum_j + K * za * zb_j
+  std::int32_t *col_zp;   // zb_j
+  float *col_mult;        // a_scale * b_scale_j (/ out_scale for s8)
+  float *col_bias;        // bias_j (/ out_scale for s8)
+  const std::int32_t *row_sum;
+  std::int32_t out_zp;
+};
+
+static inline float32x4_t dequant(int32x4_t v, const BlockTerms &t,
+                                  index_t j) {
+  return vfmaq_f32(vld1q_f32(t.col_bias + j), vcvtq_f32_s32(v),
+                   vld1q_f32(t.col_mult + j));
+}
+
+static inline void store_s32x4(std::int32_t *C, int32x4_t v,
+                               const BlockTerms &, index_t) {
+  vst1q_s32(C, v);
+}
+
+static inline void store_s32x4(float *C, int32x4_t v, const BlockTerms &t,
+                               index_t j) {
+  vst1q_f32(C, dequant(v, t, j));
+}
+
+static inline void store_s32x4(std::int8_t *C, int32x4_t v,
+                               const BlockTerms &t, index_t j) {
+  int32x4_t q = vaddq_s32(vcvtnq_s32_f32(dequant(v, t, j)),
+                          vdupq_n_s32(t.out_zp));
+  q = vminq_s32(vmaxq_s32(q, vdupq_n_s32(-128)), vdupq_n_s32(127));
+
+  std::int32_t tmp[4];
+  vst1q_s32(tmp, q);
+  for (int l = 0; l < 4; ++l)
+    C[l] = std::int8_t(tmp[l]);
+}
+
+// Corrects and requantizes the register tile, stores the valid mr x nr
+template <class OutT>
+static inline void finish_tile(int32x4_t c[8][2], OutT *C, index_t ldc,
+                               index_t mr, index_t nr, const BlockTerms &t,
+                               index_t i0, index_t j0) {
+  constexpr index_t MR = config::MR;
+  constexpr index_t NR = config::NR;
+
+  OutT tmp[MR * NR];
+  bool full = mr == MR && nr == NR;
+
+  for (index_t i = 0; i < MR; ++i) {
+    int32x4_t rs = vdupq_n_s32(t.row_sum[i0 + i]);
+
+    for (index_t h = 0; h < 2; ++h) {
+      index_t j = j0 + 4 * h;
+
+      int32x4_t v = vaddq_s32(c[i][h], vld1q_s32(t.col_term + j));
+      v = vmlsq_s32(v, vld1q_s32(t.col_zp + j), rs);
+
+      OutT *dst = full ? C + i * ldc + 4 * h : tmp + i * NR + 4 * h;
+      store_s32x4(dst, v, t, j);
+    }
+  }
+
+  if (!full)
+    for (index_t i = 0; i < mr; ++i)
+      for (index_t j = 0; j < nr; ++j)
+        C[i * ldc + j] = tmp[i * NR + j];
+}
+
+// ================================================================
+// One BM x BN block: K slices packed to s8 panels, int32 partial sums
+// in the workspace scratch, requantized by the last slice.
+// ================================================================
+template <class OutT>
+static void compute_block_int8(Workspace &ws, const std::uint8_t *A,
+                               const std::int8_t *B, OutT *C,
+                               const GemmConfig &cfg, const QuantParams &q,
+                               index_t ii, index_t jj, index_t Mb,
+                               index_t Nb) {
+  constexpr index_t BN = config::DEFAULT_BN;
+  constexpr index_t BK = config::DEFAULT_BK;
+  constexpr index_t MR = config::MR;
+  constexpr index_t NR = config::NR;
+
+  // Scratch: acc[BM][BN] | row_sum[BM] | col_sum, col_term, col_zp [BN] |
+  //          col_mult, col_bias [BN]
+  std::int32_t *acc = reinterpret_cast<std::int32_t *>(ws.scratch());
+  std::int32_t *row_sum = acc + config::DEFAULT_BM * BN;
+  std::int32_t *col_sum = row_sum + config::DEFAULT_BM;
+  std::int32_t *col_term = col_sum + BN;
+  std::int32_t *col_zp = col_term + BN;
+  float *col_mult = reinterpret_cast<float *>(col_zp + BN);
+  float *col_bias = col_mult + BN;
+
+  std::int8_t *pa = reinterpret_cast<std::int8_t *>(ws.packA());
+  std::int8_t *pb = reinterpret_cast<std::int8_t *>(ws.packB());
+
+  // Padded rows / columns of the edge tiles see zero terms
+  index_t Mp = (Mb + MR - 1) / MR * MR;
+  index_t Np = (Nb + NR - 1) / NR * NR;
+
+  std::fill(row_sum, row_sum + Mp, 0);
+  std::fill(col_sum, col_sum + Np, 0);
+
+  const float out_div = std::is_same_v<OutT, std::int8_t> ? q.out_scale : 1.f;
+  BlockTerms terms{col_term, col_zp, col_mult, col_bias, row_sum,
+                   q.out_zero_point};
+
+  index_t kk = 0;
+  do {
+    index_t Kb = std::min(BK, cfg.K - kk);
+    index_t Kp = (Kb + KGROUP - 1) / KGROUP * KGROUP;
+
+    bool first = kk == 0;
+    bool last = kk + Kb >= cfg.K;
+
+    pack_A_u8(pa, A + ii * cfg.lda + kk, Mb, Kb, cfg.lda, row_sum);
+    pack_B_s8(pb, B + kk * cfg.ldb + jj, Kb, Nb, cfg.ldb, col_sum);
+
+    // Column sums are complete once the last slice is packed
+    if (last) {
+      std::int64_t K = std::int64_t(cfg.K);
+      for (index_t j = 0; j < Np; ++j) {
+        bool valid = j < Nb;
+        std::int32_t zb = !valid          ? 0
+                          : q.b_zero_points ? q.b_zero_points[jj + j]
+                                            : q.b_zero_point;
+        float sb = !valid ? 0.0f : q.b_scales ? q.b_scales[jj + j] : q.b_scale;
+
+        col_term[j] = std::int32_t((128 - q.a_zero_point) * col_sum[j] +
+                                   K * q.a_zero_point * zb);
+        col_zp[j] = zb;
+        col_mult[j] = q.a_scale * sb / out_div;
+        col_bias[j] = q.bias && valid ? q.bias[jj + j] / out_div : 0.0f;
+      }
+    }
+
+    for (index_t i = 0; i < Mb; i += MR) {
+      for (index_t j = 0; j < Nb; j += NR) {
+
+        int32x4_t c[8][2];
+        std::int32_t *tile = acc + i * BN + j;
+
+        for (index_t r = 0; r < MR; ++r) {
+          c[r][0] = first ? vdupq_n_s32(0) : vld1q_s32(tile + r * BN);
+          c[r][1] = first ? vdupq_n_s32(0) : vld1q_s32(tile + r * BN + 4);
+        }
+
+        microkernel_s8_8x8(pa + i * Kp, pb + j * Kp, Kp, c);
+
+        if (last) {
+          finish_tile(c, C + (ii + i) * cfg.ldc + (jj + j), cfg.ldc,
+                      std::min(MR, Mb - i), std::min(NR, Nb - j), terms, i,
+                      j);
+        } else {
+          for (index_t r = 0; r < MR; ++r) {
+            vst1q_s32(tile + r * BN, c[r][0]);
+            vst1q_s32(tile + r * BN + 4, c[r][1]);
+          }
+        }
+      }
+    }
+
+    kk += BK;
+  } while (kk < cfg.K);
+}
+
+template <class OutT>
+static void gemm_int8_impl(const std::uint8_t *A, const std::int8_t *B,
+                           OutT *C, const GemmConfig &cfg,
+                           const QuantParams &q) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  index_t scratch_bytes = (BM * BN + BM + 3 * BN) * sizeof(std::int32_t) +
+                          2 * BN * sizeof(float);
+
+  detail::parallel_blocks(
+      cfg.M, cfg.N,
+      [&](Workspace &ws, index_t ii, index_t jj, index_t Mb, index_t Nb) {
+        compute_block_int8(ws, A, B, C, cfg, q, ii, jj, Mb, Nb);
+      },
+      scratch_bytes);
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, std::int32_t *C,
+               const GemmConfig &cfg, const QuantParams &q) {
+  gemm_int8_impl(A, B, C, cfg, q);
+}
+
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, float *C,
+               const GemmConfig &cfg, const QuantParams &q) {
+  gemm_int8_impl(A, B, C, cfg, q);
+}
+
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, std::int8_t *C,
+               const GemmConfig &cfg, const QuantParams &q) {
+  gemm_int8_impl(A, B, C, cfg, q);
+}
+
+} // namespace gemm
@@ -1,6 +1,10 @@
 #pragma once
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <vector>
 
 namespace gemm {
 
@@ -15,4 +19,143 @@ struct GemmConfig {
   index_t ldc;
 };
 
+// Cache blocking of the packed drivers: BM x BN blocks of C, K in BK
+// slices (packed panels BM x BK and BK x BN). Any positive sizes work
+// (the drivers treat 0 as 1); multiples of MR / NR keep every tile on
+// the full microkernel.
+struct BlockSizes {
+  index_t BM = atlas_memory::config::DEFAULT_BM;
+  index_t BN = atlas_memory::config::DEFAULT_BN;
+  index_t BK = atlas_memory::config::DEFAULT_BK;
+};
+
+// A zero block would never advance the block / K loops
+inline BlockSizes clamp_block_sizes(BlockSizes bs) {
+  bs.BM = bs.BM ? bs.BM : 1;
+  bs.BN = bs.BN ? bs.BN : 1;
+  bs.BK = bs.BK ? bs.BK : 1;
+  return bs;
+}
+
+// Per-worker accounting of one parallel region: idle = wall - busy
+// (thread start, workspace setup, waiting for the last tile)
+struct ThreadStats {
+  double wall = 0.0;          // seconds, spawn to join
+  std::vector<double> busy;   // per worker: seconds inside tiles
+  std::vector<index_t> tiles; // per worker: tiles processed
+};
+
+// Threading of the parallel drivers
+struct ParallelOptions {
+  unsigned threads = 0;         // workers; 0: hardware_concurrency()
+  ThreadStats *stats = nullptr; // filled when set
+};
+
+// One independent problem of a grouped GEMM (C += A * B)
+struct GemmProblem {
+  const float *A;
+  const float *B;
+  float *C;
+  GemmConfig cfg;
+};
+
+// Kernel family chosen by gemm_dispatch for a shape
+enum class GemmPath {
+  SkinnyN, // N <= 4: streaming GEMV-style kernel over rows of A
+  SkinnyM, // M <= 4: streaming kernel over column strips of B
+  Packed,  // everything else: v6 parallel packed
+};
+
+enum class Activation { None, Relu, Gelu, Silu };
+
+// Runtime description of the common fused epilogue
+// C = act(alpha * A * B + bias[col]) + residual[row, col]
+struct FusedEpilogue {
+  float alpha = 1.0f;
+  const float *bias = nullptr;     // per-column bias (length N), optional
+  Activation activation = Activation::None;
+  const float *residual = nullptr; // M x N matrix, optional
+  index_t ldr = 0;
+};
+
+enum class Triangle { Lower, Upper };
+
+// Symmetric rank-k / rank-2k update of the uplo triangle of an N x N C.
+// A (and B for SYR2K) are N x K.
+struct SyrkConfig {
+  index_t N;
+  index_t K;
+  index_t lda;
+  index_t ldb;
+  index_t ldc;
+  Triangle uplo = Triangle::Lower;
+};
+
+// Left-side triangular operations: A is M x M triangular (uplo), B is
+// M x N (N right-hand sides) and is overwritten with the result
+struct TriangularConfig {
+  index_t M;
+  index_t N;
+  index_t lda;
+  index_t ldb;
+  Triangle uplo = Triangle::Lower;
+  bool unit_diag = false; // diagonal of A taken as 1 (not read)
+};
+
+// Plan / accuracy report of the Strassen driver. Error bound (Higham,
+// max-norm, n = K):  max|C - C_hat| <= error_factor * u * max|A| * max|B|
+//   error_factor = 12^L (n0^2 + 5 n0) - 5 n,   n0 = n / 2^L
+// against n^2 for the conventional product (L = 0).
+struct StrassenReport {
+  int levels = 0;           // recursion depth (0: conventional v6)
+  index_t products = 1;     // base GEMMs, 7^levels
+  double flop_ratio = 1.0;  // multiply flops vs conventional, (7/8)^levels
+  double error_factor = 0.0;
+  double conventional_factor = 0.0;
+};
+
+// Blocking of the out-of-core driver: C is walked in Mc x Nc blocks, each
+// accumulated over K slabs of Kc (one step = one A and one B slab).
+struct OutOfCorePlan {
+  index_t Mc = 0, Nc = 0, Kc = 0;
+  index_t steps = 0;              // C blocks x K slabs
+  index_t a_passes = 0;           // times A is streamed from disk, N / Nc
+  index_t b_passes = 0;           // times B is streamed from disk, M / Mc
+  std::size_t resident_bytes = 0; // C block + two (A, B) slab pairs
+};
+
+// Real-GEMM decomposition of the complex GEMM
+enum class ComplexMethod {
+  ThreeM, // 3 real products (Karatsuba), 25% fewer multiplies
+  FourM,  // 4 real products, no cancellation in the imaginary part
+};
+
+// Affine quantization of the int8 GEMM: real = scale * (q - zero_point).
+// B zero points / scales are per tensor, or per column (output channel)
+// when the array pointers are set.
+struct QuantParams {
+  std::int32_t a_zero_point = 0;
+  float a_scale = 1.0f;
+  std::int32_t b_zero_point = 0;
+  const std::int32_t *b_zero_points = nullptr; // length N, optional
+  float b_scale = 1.0f;
+  const float *b_scales = nullptr;             // length N, optional
+  const float *bias = nullptr;                 // length N, real units
+  float out_scale = 1.0f;                      // s8 output only
+  std::int32_t out_zero_point = 0;             // s8 output only
+};
+
+// Back-to-back GEMMs Y = (X * W1) * W2
+// X: M x K, W1: K x N1, W2: N1 x N2, Y: M x N2
+struct ChainedGemmConfig {
+  index_t M;
+  index_t K;
+  index_t N1;
+  index_t N2;
+  index_t ldx;
+  index_t ldw1;
+  index_t ldw2;
+  index_t ldy;
+};
+
 } // namespace gemm
@@ -1,8 +1,26 @@
 #pragma once
+#include "../atlas_memory/include/atlas_memory/block_sparse.hpp"
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/conv_shape.hpp"
+#include "../atlas_memory/include/atlas_memory/half.hpp"
+#include "../atlas_memory/include/atlas_memory/mapped_matrix.hpp"
+#include "../atlas_memory/include/atlas_memory/quant_weights.hpp"
 #include "kernel_config.hpp"
 
+#include <complex>
+
 namespace gemm {
 
+using atlas_memory::bf16_t;
+using atlas_memory::BlockSparseMatrix;
+using atlas_memory::ConvLayout;
+using atlas_memory::ConvShape;
+using atlas_memory::fp16_t;
+using atlas_memory::MapMode;
+using atlas_memory::MappedMatrix;
+using atlas_memory::QuantizedWeights;
+using atlas_memory::WeightFormat;
+
 // v0 — naive triple loop
 void gemm_v0_naive(const float *A, const float *B, float *C,
                    const GemmConfig &cfg);
@@ -34,4 +52,163 @@ void gemm_v5_packed_neon(const float *A, const float *B, float *C,
 void gemm_v6_parallel(const float *A, const float *B, float *C,
                       const GemmConfig &cfg);
 
+// v5 / v6 with runtime cache blocking instead of the config defaults
+// (block-size sweeps, per-machine tuning)
+void gemm_v5_packed_neon(const float *A, const float *B, float *C,
+                         const GemmConfig &cfg, const BlockSizes &bs);
+void gemm_v6_parallel(const float *A, const float *B, float *C,
+                      const GemmConfig &cfg, const BlockSizes &bs);
+
+// v6 with an explicit worker count and optional per-worker busy / idle
+// accounting (thread-scaling studies)
+void gemm_v6_parallel(const float *A, const float *B, float *C,
+                      const GemmConfig &cfg, const BlockSizes &bs,
+                      const ParallelOptions &par);
+
+// SYRK / SYR2K — only the cfg.uplo triangle of C is computed and
+// written (the other triangle is left untouched).
+//   syrk:  C += A * A^T
+//   syr2k: C += A * B^T + B * A^T
+void gemm_syrk(const float *A, float *C, const SyrkConfig &cfg);
+void gemm_syr2k(const float *A, const float *B, float *C,
+                const SyrkConfig &cfg);
+
+// TRSM / TRMM — left side, blocked so that all but the nb x nb diagonal
+// triangles run on the packed GEMM. B is overwritten:
+//   trsm: B = A^-1 B      trmm: B = A B
+void gemm_trsm(const float *A, float *B, const TriangularConfig &cfg);
+void gemm_trmm(const float *A, float *B, const TriangularConfig &cfg);
+
+// Strassen — opt-in fast multiplication for large problems. Recurses
+// (at most config::STRASSEN_MAX_LEVELS) while sub-problems stay >=
+// crossover, with operand additions fused into packing; remainders and
+// small problems use v6. C += A * B. strassen_plan reports levels, flop
+// savings and the error bound without running anything.
+StrassenReport
+strassen_plan(const GemmConfig &cfg,
+              index_t crossover = atlas_memory::config::STRASSEN_CROSSOVER);
+StrassenReport
+gemm_strassen(const float *A, const float *B, float *C, const GemmConfig &cfg,
+              index_t crossover = atlas_memory::config::STRASSEN_CROSSOVER);
+
+// Skinny / GEMV — streaming kernels without packing, multi-threaded.
+// C += A * B. skinny_n reads A once (N small), skinny_m reads B once
+// (M small); any N / M works, but they pay off only up to about 4.
+void gemm_skinny_n(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg);
+void gemm_skinny_m(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg);
+
+// Dispatcher — routes skinny shapes to the streaming kernels and the
+// rest to v6. C += A * B.
+GemmPath gemm_select_path(const GemmConfig &cfg);
+void gemm_dispatch(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg);
+
+// DGEMM — v5 / v6 with fp64 panels and an 8x4 float64x2_t microkernel
+void gemm_v5_packed_neon(const double *A, const double *B, double *C,
+                         const GemmConfig &cfg);
+void gemm_v6_parallel(const double *A, const double *B, double *C,
+                      const GemmConfig &cfg);
+void gemm_v5_packed_neon(const double *A, const double *B, double *C,
+                         const GemmConfig &cfg, const BlockSizes &bs);
+void gemm_v6_parallel(const double *A, const double *B, double *C,
+                      const GemmConfig &cfg, const BlockSizes &bs);
+void gemm_v6_parallel(const double *A, const double *B, double *C,
+                      const GemmConfig &cfg, const BlockSizes &bs,
+                      const ParallelOptions &par);
+
+// Grouped GEMM — heterogeneous problems, tiles of all problems scheduled
+// from one cost-weighted pool inside a single parallel region
+void gemm_grouped(const GemmProblem *problems, index_t count);
+
+// Fused epilogue — C = act(alpha * A * B + bias) + residual, applied in
+// registers before the final store (see fused_gemm.hpp for custom chains)
+void gemm_fused(const float *A, const float *B, float *C,
+                const GemmConfig &cfg, const FusedEpilogue &ep);
+
+// Chained GEMM — Y = ep2(ep1(X * W1) * W2); the hidden activation is
+// produced and consumed per row panel in a per-thread L2-sized buffer
+// (ep1 may carry an M x N1 residual, ep2 an M x N2 residual)
+void gemm_chained(const float *X, const float *W1, const float *W2, float *Y,
+                  const ChainedGemmConfig &cfg, const FusedEpilogue &ep1 = {},
+                  const FusedEpilogue &ep2 = {});
+
+// Mixed precision — bf16/fp16 storage, converted to fp32 while packing,
+// fp32 accumulation. C += A * B; a bf16/fp16 C is rounded once, by the
+// microkernel store of the last K slice.
+void gemm_mixed(const float *A, const bf16_t *B, float *C,
+                const GemmConfig &cfg);
+void gemm_mixed(const float *A, const fp16_t *B, float *C,
+                const GemmConfig &cfg);
+void gemm_mixed(const bf16_t *A, const bf16_t *B, float *C,
+                const GemmConfig &cfg);
+void gemm_mixed(const fp16_t *A, const fp16_t *B, float *C,
+                const GemmConfig &cfg);
+void gemm_mixed(const bf16_t *A, const bf16_t *B, bf16_t *C,
+                const GemmConfig &cfg);
+void gemm_mixed(const fp16_t *A, const fp16_t *B, fp16_t *C,
+                const GemmConfig &cfg);
+
+// Complex GEMM (CGEMM / ZGEMM) — interleaved std::complex storage,
+// C += A * B as 3M or 4M real GEMMs; ld* are in complex elements
+void gemm_complex(const std::complex<float> *A, const std::complex<float> *B,
+                  std::complex<float> *C, const GemmConfig &cfg,
+                  ComplexMethod method = ComplexMethod::ThreeM);
+void gemm_complex(const std::complex<double> *A,
+                  const std::complex<double> *B, std::complex<double> *C,
+                  const GemmConfig &cfg,
+                  ComplexMethod method = ComplexMethod::ThreeM);
+
+// Weight-only quantization — int4/int8 B with group-wise scales,
+// dequantized to fp32 panels while packing. C += A * B; cfg.ldb is unused
+// (the weights carry their own strides).
+void gemm_mixed(const float *A, const QuantizedWeights &B, float *C,
+                const GemmConfig &cfg);
+
+// Block-sparse — B with all-zero blocks dropped (pack_block_sparse). Only
+// stored blocks are multiplied and only the A columns they touch are
+// packed; threads are balanced by stored blocks. C += A * B; cfg.ldb is
+// unused. block_cols must be a multiple of NR, block_rows <= BK and B
+// K x N; otherwise nothing is computed.
+void gemm_block_sparse(const float *A, const BlockSparseMatrix &B, float *C,
+                       const GemmConfig &cfg);
+
+// Conv2D — implicit GEMM: input patches are gathered straight into the
+// packed panels (no im2col buffer), the v6 scheduler and microkernels do
+// the rest. Layouts: NHWC input / HWIO weights / NHWC output, or NCHW /
+// OIHW / NCHW (see conv_shape.hpp). The output is overwritten; shapes with
+// a kernel, stride or dilation below 1, negative padding or no output
+// pixels leave it untouched.
+void gemm_conv2d(const float *input, const float *weights, float *output,
+                 const ConvShape &shape);
+
+// Out-of-core — file-backed A (M x K), B (K x N), C (M x N) larger than
+// RAM. C += A * B in plan-sized blocks ordered so each slab is read from
+// disk as few times as possible; a reader thread pages in the next slabs
+// while the current ones are multiplied (v6, packing straight from the
+// mapped pages), consumed slabs are released. budget bounds the working
+// set (blocks shrink below 256 for small budgets); out_of_core_plan
+// reports the blocking without running anything. An empty plan
+// (steps == 0) is returned, and nothing run, for unmapped files,
+// mismatched shapes or a budget too small for any blocking.
+OutOfCorePlan
+out_of_core_plan(const GemmConfig &cfg,
+                 std::size_t budget = atlas_memory::config::OUT_OF_CORE_BYTES);
+OutOfCorePlan
+gemm_out_of_core(const MappedMatrix &A, const MappedMatrix &B, MappedMatrix &C,
+                 std::size_t budget = atlas_memory::config::OUT_OF_CORE_BYTES);
+
+// INT8 — u8 x s8 with int32 accumulation (NEON sdot when available).
+// C is overwritten with the requantized result of the output type:
+//   s32: zero-point corrected accumulator (bias ignored)
+//   f32: a_scale * b_scale[j] * acc + bias[j]
+//   s8:  saturate(round(f32 / out_scale) + out_zero_point)
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, std::int32_t *C,
+               const GemmConfig &cfg, const QuantParams &q = {});
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, float *C,
+               const GemmConfig &cfg, const QuantParams &q = {});
+void gemm_int8(const std::uint8_t *A, const std::int8_t *B, std::int8_t *C,
+               const GemmConfig &cfg, const QuantParams &q = {});
+
 } // namespace gemm
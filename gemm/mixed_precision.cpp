@@ -0,0 +1,76 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/half.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <type_traits>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// ================================================================
+// v6 scheduling over blocks; pack_A / pack_B overloads widen the
+// 16-bit operands (or dequantize int4/int8 weights), the fp32
+// microkernel accumulates.
+// ================================================================
+template <class TA, class TB, class TC>
+static void gemm_mixed_impl(const TA *A, const TB *B, TC *C,
+                            const GemmConfig &cfg) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  // 16-bit C: per-thread fp32 accumulator block
+  index_t scratch_bytes =
+      std::is_same_v<TC, float> ? 0 : BM * BN * sizeof(float);
+
+  detail::parallel_blocks(
+      cfg.M, cfg.N,
+      [&](Workspace &ws, index_t ii, index_t jj, index_t Mb, index_t Nb) {
+        detail::compute_block(ws, A, B, C, cfg, ii, jj, Mb, Nb,
+                              epilogue::Identity{}, true);
+      },
+      scratch_bytes);
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_mixed(const float *A, const bf16_t *B, float *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const float *A, const fp16_t *B, float *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const bf16_t *A, const bf16_t *B, float *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const fp16_t *A, const fp16_t *B, float *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const bf16_t *A, const bf16_t *B, bf16_t *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const fp16_t *A, const fp16_t *B, fp16_t *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, B, C, cfg);
+}
+
+void gemm_mixed(const float *A, const QuantizedWeights &B, float *C,
+                const GemmConfig &cfg) {
+  gemm_mixed_impl(A, &B, C, cfg);
+}
+
+} // namespace gemm
@@ -0,0 +1,229 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/mapped_matrix.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// One step: C[i0:, j0:] += A[i0:, k0:] * B[k0:, j0:] on plan-sized blocks
+struct OutOfCoreStep {
+  index_t i0, j0, k0;
+};
+
+static index_t ceil_div(index_t a, index_t b) { return (a + b - 1) / b; }
+
+// Multiple of the default block while one fits, else of the 8-wide micro
+// tile (small budgets), else whatever is left
+static index_t round_block(index_t x, index_t block) {
+  if (x >= block)
+    return x / block * block;
+  return x >= 8 ? x / 8 * 8 : x;
+}
+
+// ================================================================
+// Plan: the largest square C block whose working set (C block plus two
+// A / B slab pairs, K slabs of a quarter of the block) fits the budget,
+// then the block widened with whatever a short M leaves over. Budgets
+// below one default block get smaller blocks; the working set never
+// exceeds the budget (no plan when it cannot hold a single element).
+// ================================================================
+OutOfCorePlan out_of_core_plan(const GemmConfig &cfg, std::size_t budget) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+  constexpr index_t BK = config::DEFAULT_BK;
+
+  OutOfCorePlan plan;
+  if (cfg.M == 0 || cfg.N == 0 || cfg.K == 0)
+    return plan;
+
+  const index_t floats = budget / sizeof(float);
+
+  // S^2 + 2 (S Kc + Kc S) with Kc = S / 4: 2 S^2 floats
+  index_t S = BM;
+  if (2 * S * S <= floats) {
+    while (2 * (S + BM) * (S + BM) <= floats)
+      S += BM;
+  } else {
+    S = 0;
+    while (2 * (S + 1) * (S + 1) <= floats)
+      ++S;
+    S = round_block(S, BM);
+  }
+
+  plan.Mc = std::min(cfg.M, S);
+  index_t Kc = S >= BM ? std::max(BK, S / 4 / BK * BK)
+                       : std::max<index_t>(1, round_block(S / 4, BK));
+  Kc = std::min(cfg.K, Kc);
+
+  // Nc from what the A slabs leave; thinner K slabs when that is nothing
+  index_t Nc = 0;
+  for (;;) {
+    index_t slabs_a = 2 * plan.Mc * Kc;
+    index_t avail = floats > slabs_a ? floats - slabs_a : 0;
+    Nc = round_block(avail / (plan.Mc + 2 * Kc), BN);
+    if (Nc > 0 || Kc == 1)
+      break;
+    Kc = round_block(Kc / 2, BK);
+  }
+  if (plan.Mc == 0 || Nc == 0)
+    return {};
+
+  plan.Kc = Kc;
+  plan.Nc = std::min(cfg.N, Nc);
+
+  index_t blocks_m = ceil_div(cfg.M, plan.Mc);
+  index_t blocks_n = ceil_div(cfg.N, plan.Nc);
+
+  plan.steps = blocks_m * blocks_n * ceil_div(cfg.K, plan.Kc);
+  plan.a_passes = blocks_n;
+  plan.b_passes = blocks_m;
+  plan.resident_bytes =
+      sizeof(float) * (plan.Mc * plan.Nc +
+                       2 * (plan.Mc * plan.Kc + plan.Kc * plan.Nc));
+  return plan;
+}
+
+// ================================================================
+// Step order: row blocks of C, column blocks serpentine within a row
+// block, K slabs serpentine within a C block. Consecutive steps then
+// share a slab at every block boundary (the last A slab when moving
+// along a row, the last B slab when moving down), so it is reused while
+// still resident instead of being read again.
+// ================================================================
+static std::vector<OutOfCoreStep> build_steps(const GemmConfig &cfg,
+                                              const OutOfCorePlan &plan) {
+  std::vector<OutOfCoreStep> steps;
+  steps.reserve(plan.steps);
+
+  const index_t bn = ceil_div(cfg.N, plan.Nc);
+  const index_t bk = ceil_div(cfg.K, plan.Kc);
+  bool k_forward = true;
+
+  for (index_t bi = 0; bi * plan.Mc < cfg.M; ++bi) {
+    for (index_t t = 0; t < bn; ++t) {
+      index_t bj = bi % 2 == 0 ? t : bn - 1 - t;
+
+      for (index_t s = 0; s < bk; ++s) {
+        index_t kb = k_forward ? s : bk - 1 - s;
+        steps.push_back({bi * plan.Mc, bj * plan.Nc, kb * plan.Kc});
+      }
+      k_forward = !k_forward;
+    }
+  }
+
+  return steps;
+}
+
+// Row segments [c0, c0 + cols) of rows [r0, r1) of a mapped matrix
+template <class RangeFn>
+static void for_rows(const float *M, index_t ld, index_t r0, index_t r1,
+                     index_t c0, index_t cols, const RangeFn &fn) {
+  for (index_t r = r0; r < r1; ++r)
+    fn(M + r * ld + c0, cols * sizeof(float));
+}
+
+// ================================================================
+// Read-ahead of one step (reader thread): hint the kernel, then touch
+// every page so the reads complete here and not in the compute threads
+// ================================================================
+static void prefetch_step(const MappedMatrix &A, const MappedMatrix &B,
+                          const MappedMatrix &C, const GemmConfig &cfg,
+                          const OutOfCorePlan &plan, const OutOfCoreStep &s,
+                          bool c_block) {
+  const index_t mc = std::min(plan.Mc, cfg.M - s.i0);
+  const index_t nc = std::min(plan.Nc, cfg.N - s.j0);
+  const index_t kc = std::min(plan.Kc, cfg.K - s.k0);
+
+  auto fetch = [](const float *p, std::size_t bytes) {
+    advise_willneed(p, bytes);
+
+    volatile float sink = 0.0f;
+    const index_t n = bytes / sizeof(float);
+    for (index_t i = 0; i < n; i += config::PAGE_SIZE / sizeof(float))
+      sink = sink + p[i];
+    sink = sink + p[n - 1];
+  };
+
+  for_rows(A.data(), cfg.lda, s.i0, s.i0 + mc, s.k0, kc, fetch);
+  for_rows(B.data(), cfg.ldb, s.k0, s.k0 + kc, s.j0, nc, fetch);
+  if (c_block)
+    for_rows(C.data(), cfg.ldc, s.i0, s.i0 + mc, s.j0, nc, fetch);
+}
+
+// ================================================================
+// Public API
+// ================================================================
+OutOfCorePlan gemm_out_of_core(const MappedMatrix &A, const MappedMatrix &B,
+                               MappedMatrix &C, std::size_t budget) {
+  // Unmapped files or inconsistent shapes: nothing to run
+  if (!A.valid() || !B.valid() || !C.valid() || B.rows() != A.cols() ||
+      C.rows() != A.rows() || C.cols() != B.cols())
+    return {};
+
+  const GemmConfig cfg{A.rows(), B.cols(), A.cols(), A.ld(), B.ld(), C.ld()};
+
+  OutOfCorePlan plan = out_of_core_plan(cfg, budget);
+  if (plan.steps == 0)
+    return plan;
+
+  std::vector<OutOfCoreStep> steps = build_steps(cfg, plan);
+
+  auto same_c = [](const OutOfCoreStep &x, const OutOfCoreStep &y) {
+    return x.i0 == y.i0 && x.j0 == y.j0;
+  };
+
+  prefetch_step(A, B, C, cfg, plan, steps[0], true);
+
+  for (index_t n = 0; n < steps.size(); ++n) {
+    const OutOfCoreStep &s = steps[n];
+    const OutOfCoreStep *next = n + 1 < steps.size() ? &steps[n + 1] : nullptr;
+
+    const index_t mc = std::min(plan.Mc, cfg.M - s.i0);
+    const index_t nc = std::min(plan.Nc, cfg.N - s.j0);
+    const index_t kc = std::min(plan.Kc, cfg.K - s.k0);
+
+    // Next slabs stream in while this one is multiplied
+    std::thread reader;
+    if (next)
+      reader = std::thread([&, next] {
+        prefetch_step(A, B, C, cfg, plan, *next, !same_c(s, *next));
+      });
+
+    // Packed panels are built straight from the mapped pages
+    gemm_v6_parallel(A.data() + s.i0 * cfg.lda + s.k0,
+                     B.data() + s.k0 * cfg.ldb + s.j0,
+                     C.data() + s.i0 * cfg.ldc + s.j0,
+                     {mc, nc, kc, cfg.lda, cfg.ldb, cfg.ldc});
+
+    if (reader.joinable())
+      reader.join();
+
+    // Release what the next step does not reuse
+    if (!next || next->i0 != s.i0 || next->k0 != s.k0)
+      for_rows(A.data(), cfg.lda, s.i0, s.i0 + mc, s.k0, kc,
+               advise_dontneed);
+    if (!next || next->k0 != s.k0 || next->j0 != s.j0)
+      for_rows(B.data(), cfg.ldb, s.k0, s.k0 + kc, s.j0, nc,
+               advise_dontneed);
+
+    // Finished C block: start its writeback, then drop it
+    if (!next || !same_c(s, *next)) {
+      for (index_t r = s.i0; r < s.i0 + mc; ++r) {
+        float *row = C.data() + r * cfg.ldc + s.j0;
+        flush_async(row, nc * sizeof(float));
+        advise_dontneed(row, nc * sizeof(float));
+      }
+    }
+  }
+
+  return plan;
+}
+
+} // namespace gemm
@@ -0,0 +1,529 @@
+#pragma once
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "epilogue.hpp"
+#include "kernel_config.hpp"
+#include "instrument.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Shared building blocks of the packed drivers (v5, v6, grouped, fused,
+// chained), for fp32 panels and fp64 (DGEMM) panels.
+// Internal header: not part of the public kernels.hpp interface.
+
+namespace gemm::detail {
+
+// ================================================================
+// Tile stores: fp32 directly, bf16/fp16 narrowed on the way out
+// ================================================================
+static inline void store_f32x4(float *C, float32x4_t v) { vst1q_f32(C, v); }
+
+template <class OutT> static inline void store_f32x4(OutT *C, float32x4_t v) {
+  float tmp[4];
+  vst1q_f32(tmp, v);
+  for (int j = 0; j < 4; ++j)
+    atlas_memory::convert(C[j], tmp[j]);
+}
+
+// ================================================================
+// 8x8 NEON microkernel (C tile accumulated in registers)
+//
+// Cin:     fp32 tile to accumulate onto (nullptr: start from zero)
+// Cout:    destination tile (may alias Cin; bf16/fp16 are narrowed)
+// last:    final K slice — apply the epilogue before the store
+// row/col: global coordinates of the tile, forwarded to the epilogue
+// ================================================================
+template <class Epilogue, class OutT>
+static inline void microkernel_8x8(const float *A, const float *B, index_t K,
+                                   index_t Nb, const float *Cin, index_t ldin,
+                                   OutT *Cout, index_t ldout, bool last,
+                                   const Epilogue &ep, index_t row,
+                                   index_t col) {
+  float32x4_t c[8][2];
+
+  // Load C tile
+  for (int i = 0; i < 8; ++i) {
+    c[i][0] = Cin ? vld1q_f32(Cin + i * ldin) : vdupq_n_f32(0.0f);
+    c[i][1] = Cin ? vld1q_f32(Cin + i * ldin + 4) : vdupq_n_f32(0.0f);
+  }
+
+  for (index_t k = 0; k < K; ++k) {
+
+    float32x4_t b0 = vld1q_f32(B + k * Nb);
+    float32x4_t b1 = vld1q_f32(B + k * Nb + 4);
+
+    for (int i = 0; i < 8; ++i) {
+      float32x4_t a = vdupq_n_f32(A[i * K + k]);
+      c[i][0] = vfmaq_f32(c[i][0], b0, a);
+      c[i][1] = vfmaq_f32(c[i][1], b1, a);
+    }
+  }
+
+  // Epilogue while the tile is still in registers
+  if (last) {
+    for (int i = 0; i < 8; ++i) {
+      c[i][0] = ep(c[i][0], row + i, col);
+      c[i][1] = ep(c[i][1], row + i, col + 4);
+    }
+  }
+
+  // Store back
+  for (int i = 0; i < 8; ++i) {
+    store_f32x4(Cout + i * ldout, c[i][0]);
+    store_f32x4(Cout + i * ldout + 4, c[i][1]);
+  }
+}
+
+// ================================================================
+// 8x4 NEON fp64 microkernel (DGEMM): two float64x2_t per row, so the 16
+// accumulators plus operands fit the 32 vector registers
+// ================================================================
+template <class Epilogue>
+static inline void microkernel_8x4(const double *A, const double *B,
+                                   index_t K, index_t Nb, const double *Cin,
+                                   index_t ldin, double *Cout, index_t ldout,
+                                   bool last, const Epilogue &ep, index_t row,
+                                   index_t col) {
+  float64x2_t c[8][2];
+
+  for (int i = 0; i < 8; ++i) {
+    c[i][0] = Cin ? vld1q_f64(Cin + i * ldin) : vdupq_n_f64(0.0);
+    c[i][1] = Cin ? vld1q_f64(Cin + i * ldin + 2) : vdupq_n_f64(0.0);
+  }
+
+  for (index_t k = 0; k < K; ++k) {
+
+    float64x2_t b0 = vld1q_f64(B + k * Nb);
+    float64x2_t b1 = vld1q_f64(B + k * Nb + 2);
+
+    for (int i = 0; i < 8; ++i) {
+      float64x2_t a = vdupq_n_f64(A[i * K + k]);
+      c[i][0] = vfmaq_f64(c[i][0], b0, a);
+      c[i][1] = vfmaq_f64(c[i][1], b1, a);
+    }
+  }
+
+  if (last) {
+    for (int i = 0; i < 8; ++i) {
+      c[i][0] = ep(c[i][0], row + i, col);
+      c[i][1] = ep(c[i][1], row + i, col + 2);
+    }
+  }
+
+  for (int i = 0; i < 8; ++i) {
+    vst1q_f64(Cout + i * ldout, c[i][0]);
+    vst1q_f64(Cout + i * ldout + 2, c[i][1]);
+  }
+}
+
+// Register tile of the packed drivers per panel scalar
+template <class T> struct MicroTile;
+
+template <> struct MicroTile<float> {
+  static constexpr index_t MR = 8;
+  static constexpr index_t NR = 8;
+};
+
+template <> struct MicroTile<double> {
+  static constexpr index_t MR = 8;
+  static constexpr index_t NR = 4;
+};
+
+// ================================================================
+// Scalar cleanup for partial (mr < MR or nr < NR) tiles
+// ================================================================
+template <class Epilogue, class T, class OutT>
+static inline void edge_kernel(const T *A, const T *B, index_t mr,
+                               index_t nr, index_t K, index_t Nb,
+                               const T *Cin, index_t ldin, OutT *Cout,
+                               index_t ldout, bool last, const Epilogue &ep,
+                               index_t row, index_t col) {
+  for (index_t i = 0; i < mr; ++i) {
+    for (index_t j = 0; j < nr; ++j) {
+
+      T sum = Cin ? Cin[i * ldin + j] : T(0);
+
+      for (index_t k = 0; k < K; ++k)
+        sum += A[i * K + k] * B[k * Nb + j];
+
+      atlas_memory::convert(Cout[i * ldout + j],
+                            last ? ep(sum, row + i, col + j) : sum);
+    }
+  }
+}
+
+// ================================================================
+// Operand packing of one K slice. Strided arrays are offset by the block
+// coordinates; descriptor operands (quantized weights, one component of
+// a complex matrix) are converted by their own pack_A / pack_B overloads.
+// ================================================================
+
+// One real component of an interleaved complex operand (3M / 4M GEMM)
+template <class T> struct ComplexOperand {
+  const std::complex<T> *data;
+  atlas_memory::ComplexPart part;
+};
+
+// B = M^T for a row-major M with leading dimension cfg.ldb
+struct TransposedOperand {
+  const float *data;
+};
+
+// alpha * M (e.g. -A for the trailing updates of TRSM)
+struct ScaledOperand {
+  const float *data;
+  float alpha;
+};
+
+// sum_t coef[t] * src[t] of up to 4 equally strided sub-matrices
+// (Strassen operand additions, fused into packing)
+struct LinearOperand {
+  const float *src[4];
+  float coef[4];
+  int terms;
+};
+
+// Implicit im2col patch matrix of a convolution input (conv_shape.hpp):
+// the A operand for NHWC, the B operand of one image for NCHW
+struct ConvOperand {
+  const float *input;
+  atlas_memory::ConvShape shape;
+};
+
+template <class T, class TA>
+inline void pack_a_block(T *dst, const TA *A, const GemmConfig &cfg,
+                         index_t ii, index_t kk, index_t Mb, index_t Kb) {
+  atlas_memory::pack_A(dst, A + ii * cfg.lda + kk, Mb, Kb, cfg.lda);
+}
+
+template <class T>
+inline void pack_a_block(T *dst, const ComplexOperand<T> *A,
+                         const GemmConfig &cfg, index_t ii, index_t kk,
+                         index_t Mb, index_t Kb) {
+  atlas_memory::pack_A(dst, A->data + ii * cfg.lda + kk, Mb, Kb, cfg.lda,
+                       A->part);
+}
+
+inline void pack_a_block(float *dst, const ScaledOperand *A,
+                         const GemmConfig &cfg, index_t ii, index_t kk,
+                         index_t Mb, index_t Kb) {
+  atlas_memory::pack_A(dst, A->data + ii * cfg.lda + kk, Mb, Kb, cfg.lda);
+  for (index_t i = 0; i < Mb * Kb; ++i)
+    dst[i] *= A->alpha;
+}
+
+inline void pack_a_block(float *dst, const LinearOperand *A,
+                         const GemmConfig &cfg, index_t ii, index_t kk,
+                         index_t Mb, index_t Kb) {
+  const float *src[4];
+  for (int t = 0; t < A->terms; ++t)
+    src[t] = A->src[t] + ii * cfg.lda + kk;
+  atlas_memory::pack_A(dst, src, A->coef, A->terms, Mb, Kb, cfg.lda);
+}
+
+inline void pack_a_block(float *dst, const ConvOperand *A, const GemmConfig &,
+                         index_t ii, index_t kk, index_t Mb, index_t Kb) {
+  atlas_memory::pack_A(dst, A->input, A->shape, ii, kk, Mb, Kb);
+}
+
+template <class T, class TB>
+inline void pack_b_block(T *dst, const TB *B, const GemmConfig &cfg,
+                         index_t kk, index_t jj, index_t Kb, index_t Nb) {
+  atlas_memory::pack_B(dst, B + kk * cfg.ldb + jj, Kb, Nb, cfg.ldb);
+}
+
+inline void pack_b_block(float *dst, const atlas_memory::QuantizedWeights *B,
+                         const GemmConfig &, index_t kk, index_t jj,
+                         index_t Kb, index_t Nb) {
+  atlas_memory::pack_B(dst, *B, kk, jj, Kb, Nb);
+}
+
+inline void pack_b_block(float *dst, const TransposedOperand *B,
+                         const GemmConfig &cfg, index_t kk, index_t jj,
+                         index_t Kb, index_t Nb) {
+  atlas_memory::pack_B_transposed(dst, B->data + jj * cfg.ldb + kk, Kb, Nb,
+                                  cfg.ldb);
+}
+
+inline void pack_b_block(float *dst, const LinearOperand *B,
+                         const GemmConfig &cfg, index_t kk, index_t jj,
+                         index_t Kb, index_t Nb) {
+  const float *src[4];
+  for (int t = 0; t < B->terms; ++t)
+    src[t] = B->src[t] + kk * cfg.ldb + jj;
+  atlas_memory::pack_B(dst, src, B->coef, B->terms, Kb, Nb, cfg.ldb);
+}
+
+inline void pack_b_block(float *dst, const ConvOperand *B, const GemmConfig &,
+                         index_t kk, index_t jj, index_t Kb, index_t Nb) {
+  atlas_memory::pack_B(dst, B->input, B->shape, kk, jj, Kb, Nb);
+}
+
+template <class T>
+inline void pack_b_block(T *dst, const ComplexOperand<T> *B,
+                         const GemmConfig &cfg, index_t kk, index_t jj,
+                         index_t Kb, index_t Nb) {
+  atlas_memory::pack_B(dst, B->data + kk * cfg.ldb + jj, Kb, Nb, cfg.ldb,
+                       B->part);
+}
+
+// ================================================================
+// C[ii:ii+Mb, jj:jj+Nb] = ep(beta * C + A[ii:ii+Mb, :] * B[:, jj:jj+Nb])
+//
+// beta is 1 (accumulate) or 0 (overwrite). Mb <= BM and Nb <= BN of the
+// workspace. K is walked in the workspace's BK slices; each slice packs one A and one B
+// block (widening bf16/fp16 sources and dequantizing quantized weights
+// to fp32) and sweeps the micro tiles.
+// The epilogue runs on the last slice only (also when K == 0, so
+// overwrite + epilogue is always applied).
+//
+// The panel scalar T (float / double) comes from the workspace. A C of
+// that type accumulates in place. bf16/fp16 C keeps its fp32 partial sums
+// in the workspace scratch region (>= Mb * Nb floats) and is narrowed
+// once, by the store of the last slice.
+// ================================================================
+template <class Epilogue, class T, class TA, class TB, class TC>
+inline void compute_block(atlas_memory::BasicWorkspace<T> &ws, const TA *A,
+                          const TB *B, TC *C, const GemmConfig &cfg,
+                          index_t ii, index_t jj, index_t Mb, index_t Nb,
+                          const Epilogue &ep, bool accumulate) {
+  const index_t BK = ws.block_k();
+  constexpr index_t MR = MicroTile<T>::MR;
+  constexpr index_t NR = MicroTile<T>::NR;
+  constexpr bool f32_out = std::is_same_v<TC, T>;
+
+  // Accumulator of the block: C itself or the scratch region
+  T *acc;
+  index_t ldacc;
+
+  if constexpr (f32_out) {
+    acc = C + ii * cfg.ldc + jj;
+    ldacc = cfg.ldc;
+  } else {
+    acc = ws.scratch();
+    ldacc = Nb;
+
+    if (accumulate)
+      for (index_t i = 0; i < Mb; ++i)
+        for (index_t j = 0; j < Nb; ++j)
+          acc[i * ldacc + j] =
+              atlas_memory::to_float(C[(ii + i) * cfg.ldc + jj + j]);
+  }
+
+  index_t kk = 0;
+  do {
+    index_t Kb = std::min(BK, cfg.K - kk);
+
+    bool load_c = accumulate || kk > 0;
+    bool last = kk + Kb >= cfg.K;
+
+    {
+      instrument::PhaseScope phase(instrument::Phase::PackA);
+      pack_a_block(ws.packA(), A, cfg, ii, kk, Mb, Kb);
+    }
+    {
+      instrument::PhaseScope phase(instrument::Phase::PackB);
+      pack_b_block(ws.packB(), B, cfg, kk, jj, Kb, Nb);
+    }
+
+    for (index_t i = 0; i < Mb; i += MR) {
+      index_t mr = std::min(MR, Mb - i);
+
+      // Full tiles of the row first, then its ragged end (or the whole
+      // row when it is short): one phase switch per row of tiles
+      const index_t full = mr == MR ? Nb / NR * NR : 0;
+
+      auto tile = [&](index_t j) {
+        index_t nr = std::min(NR, Nb - j);
+
+        T *tile_acc = acc + i * ldacc + j;
+        const T *cin = load_c ? tile_acc : nullptr;
+        const T *aptr = ws.packA() + i * Kb;
+        const T *bptr = ws.packB() + j;
+
+        auto run = [&](auto *cout, index_t ldout) {
+          if (mr == MR && nr == NR) {
+            if constexpr (std::is_same_v<T, double>)
+              microkernel_8x4(aptr, bptr, Kb, Nb, cin, ldacc, cout, ldout,
+                              last, ep, ii + i, jj + j);
+            else
+              microkernel_8x8(aptr, bptr, Kb, Nb, cin, ldacc, cout, ldout,
+                              last, ep, ii + i, jj + j);
+          } else
+            edge_kernel(aptr, bptr, mr, nr, Kb, Nb, cin, ldacc, cout, ldout,
+                        last, ep, ii + i, jj + j);
+        };
+
+        // Narrowing store only on the last slice of a bf16/fp16 C
+        if (f32_out || !last)
+          run(tile_acc, ldacc);
+        else
+          run(C + (ii + i) * cfg.ldc + (jj + j), cfg.ldc);
+      };
+
+      {
+        instrument::PhaseScope phase(instrument::Phase::Microkernel);
+        for (index_t j = 0; j < full; j += NR)
+          tile(j);
+      }
+      if (full < Nb) {
+        instrument::PhaseScope phase(instrument::Phase::Edge);
+        for (index_t j = full; j < Nb; j += NR)
+          tile(j);
+      }
+    }
+
+    kk += BK;
+  } while (kk < cfg.K);
+}
+
+// C += A * B over one block (v5/v6 semantics)
+template <class T>
+inline void compute_block(atlas_memory::BasicWorkspace<T> &ws, const T *A,
+                          const T *B, T *C, const GemmConfig &cfg, index_t ii,
+                          index_t jj, index_t Mb, index_t Nb) {
+  compute_block(ws, A, B, C, cfg, ii, jj, Mb, Nb, epilogue::Identity{}, true);
+}
+
+// ================================================================
+// Dynamic tile scheduling: fn(ws, tile_id) for every tile_id in
+// [0, total_tiles), one BasicWorkspace<T> per worker thread (with an
+// optional per-thread scratch region of scratch_bytes), sized for the
+// block sizes bs. par.threads workers (default: one per core); with
+// par.stats set, the wall time and each worker's busy time (inside fn)
+// and tile count are recorded.
+// ================================================================
+template <class T = float, class TileFn>
+inline void parallel_tiles(index_t total_tiles, const TileFn &fn,
+                           index_t scratch_bytes = 0,
+                           const BlockSizes &bs = {},
+                           const ParallelOptions &par = {}) {
+  using clock = std::chrono::steady_clock;
+  constexpr index_t MR = MicroTile<T>::MR;
+  constexpr index_t NR = MicroTile<T>::NR;
+
+  // No work: still reset the stats, a reused ThreadStats must not keep
+  // the previous call's figures
+  if (total_tiles == 0) {
+    if (ThreadStats *stats = par.stats) {
+      stats->wall = 0.0;
+      stats->busy.clear();
+      stats->tiles.clear();
+    }
+    return;
+  }
+
+  const BlockSizes blocks = clamp_block_sizes(bs);
+
+  unsigned num_threads = par.threads;
+  if (num_threads == 0)
+    num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  num_threads = unsigned(std::min<index_t>(num_threads, total_tiles));
+
+  ThreadStats *stats = par.stats;
+  if (stats) {
+    stats->busy.assign(num_threads, 0.0);
+    stats->tiles.assign(num_threads, 0);
+  }
+
+  std::atomic<index_t> tile_counter(0);
+  auto start = clock::now();
+
+  trace::Span call_span(trace::Name::Call, std::uint32_t(total_tiles));
+
+#ifdef ATLAS_INSTRUMENT
+  instrument::CallRecorder rec(num_threads);
+#endif
+
+  auto worker = [&](unsigned id) {
+#ifdef ATLAS_INSTRUMENT
+    rec.worker_begin(id);
+#endif
+    atlas_memory::BasicWorkspace<T> ws = [&] {
+      trace::Span setup(trace::Name::Setup);
+      return atlas_memory::BasicWorkspace<T>(blocks.BM, blocks.BN, blocks.BK,
+                                             MR, NR, scratch_bytes);
+    }();
+
+    while (true) {
+
+      index_t tile_id = tile_counter.fetch_add(1);
+      if (tile_id >= total_tiles)
+        break;
+
+#ifdef ATLAS_INSTRUMENT
+      instrument::CallRecorder::Tile tile(rec, id);
+#endif
+      trace::Span tile_span(trace::Name::Tile, std::uint32_t(tile_id));
+
+      if (!stats) {
+        fn(ws, tile_id);
+        continue;
+      }
+
+      auto t0 = clock::now();
+      fn(ws, tile_id);
+      stats->busy[id] += std::chrono::duration<double>(clock::now() - t0).count();
+      ++stats->tiles[id];
+    }
+#ifdef ATLAS_INSTRUMENT
+    rec.worker_end(id);
+#endif
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+
+  for (unsigned t = 0; t < num_threads; ++t)
+    threads.emplace_back(worker, t);
+
+  for (auto &th : threads)
+    th.join();
+
+#ifdef ATLAS_INSTRUMENT
+  rec.finish();
+#endif
+
+  if (stats)
+    stats->wall = std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// BM x BN tiles of C, row-major tile order, fn(ws, ii, jj, Mb, Nb)
+template <class T = float, class BlockFn>
+inline void parallel_blocks(index_t M, index_t N, const BlockFn &fn,
+                            index_t scratch_bytes = 0,
+                            const BlockSizes &bs = {},
+                            const ParallelOptions &par = {}) {
+  const BlockSizes blocks = clamp_block_sizes(bs);
+  const index_t BM = blocks.BM;
+  const index_t BN = blocks.BN;
+
+  index_t tiles_m = (M + BM - 1) / BM;
+  index_t tiles_n = (N + BN - 1) / BN;
+
+  parallel_tiles<T>(
+      tiles_m * tiles_n,
+      [&](atlas_memory::BasicWorkspace<T> &ws, index_t tile_id) {
+        index_t ii = (tile_id / tiles_n) * BM;
+        index_t jj = (tile_id % tiles_n) * BN;
+
+        index_t Mb = std::min(BM, M - ii);
+        index_t Nb = std::min(BN, N - jj);
+
+        fn(ws, ii, jj, Mb, Nb);
+      },
+      scratch_bytes, blocks, par);
+}
+
+} // namespace gemm::detail
@@ -0,0 +1,309 @@
+#include "perf_counters.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gemm::perf {
+
+static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+const char *event_name(Event e) {
+  switch (e) {
+  case Event::Cycles:
+    return "cycles";
+  case Event::Instructions:
+    return "instructions";
+  case Event::L1DAccesses:
+    return "l1d_accesses";
+  case Event::L1DMisses:
+    return "l1d_misses";
+  case Event::LLCAccesses:
+    return "llc_accesses";
+  case Event::LLCMisses:
+    return "llc_misses";
+  case Event::DTLBMisses:
+    return "dtlb_misses";
+  case Event::FPOps:
+    return "fp_ops";
+  default:
+    return "?";
+  }
+}
+
+const char *phase_name(Phase p) {
+  switch (p) {
+  case Phase::PackA:
+    return "pack_a";
+  case Phase::PackB:
+    return "pack_b";
+  case Phase::Microkernel:
+    return "microkernel";
+  case Phase::Edge:
+    return "edge";
+  default:
+    return "?";
+  }
+}
+
+// ================================================================
+// Counts
+// ================================================================
+Counts &Counts::operator+=(const Counts &o) {
+  for (std::size_t e = 0; e < NUM_EVENTS; ++e) {
+    value[e] += o.value[e];
+    valid[e] = valid[e] || o.valid[e];
+  }
+  return *this;
+}
+
+static double ratio(const Counts &c, Event num, Event den, double scale) {
+  if (!c.has(num) || !c.has(den) || c[den] == 0)
+    return NaN;
+  return scale * double(c[num]) / double(c[den]);
+}
+
+double Counts::ipc() const {
+  return ratio(*this, Event::Instructions, Event::Cycles, 1.0);
+}
+
+double Counts::l1d_miss_rate() const {
+  return ratio(*this, Event::L1DMisses, Event::L1DAccesses, 1.0);
+}
+
+double Counts::llc_miss_rate() const {
+  return ratio(*this, Event::LLCMisses, Event::LLCAccesses, 1.0);
+}
+
+double Counts::dtlb_mpki() const {
+  return ratio(*this, Event::DTLBMisses, Event::Instructions, 1000.0);
+}
+
+double Counts::flops_per_cycle(double flops) const {
+  if (flops > 0.0)
+    return has(Event::Cycles) && (*this)[Event::Cycles] > 0
+               ? flops / double((*this)[Event::Cycles])
+               : NaN;
+  return ratio(*this, Event::FPOps, Event::Cycles, 1.0);
+}
+
+// ================================================================
+// CounterSet
+// ================================================================
+#ifdef __linux__
+
+static bool event_attr(Event e, perf_event_attr &attr) {
+  auto cache = [](std::uint64_t id, std::uint64_t result) {
+    return id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+  };
+
+  switch (e) {
+  case Event::Cycles:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    return true;
+  case Event::Instructions:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    return true;
+  case Event::L1DAccesses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = cache(PERF_COUNT_HW_CACHE_L1D,
+                        PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+    return true;
+  case Event::L1DMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config =
+        cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+    return true;
+  case Event::LLCAccesses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config =
+        cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+    return true;
+  case Event::LLCMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config =
+        cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+    return true;
+  case Event::DTLBMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config =
+        cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS);
+    return true;
+  case Event::FPOps: {
+    // The FP-operation event is model specific (FP_ARITH_INST_RETIRED.*
+    // on x86, an IMPDEF event on Apple cores): raw code from the
+    // environment, e.g. ATLAS_PERF_FP_EVENT=0x74 for ARMv8 ASE_SPEC
+    const char *raw = std::getenv("ATLAS_PERF_FP_EVENT");
+    if (!raw || !*raw)
+      return false;
+    attr.type = PERF_TYPE_RAW;
+    attr.config = std::strtoull(raw, nullptr, 16);
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+static int open_event(Event e, bool inherit) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  if (!event_attr(e, attr))
+    return -1;
+
+  attr.disabled = 1;
+  attr.inherit = inherit ? 1 : 0;
+  attr.exclude_kernel = 1; // allowed at perf_event_paranoid <= 2
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // This thread (and, with inherit, its future children), any CPU
+  long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  return fd < 0 ? -1 : int(fd);
+}
+
+CounterSet::CounterSet(bool inherit) {
+  for (std::size_t e = 0; e < NUM_EVENTS; ++e)
+    fd_[e] = open_event(Event(e), inherit);
+}
+
+CounterSet::~CounterSet() {
+  for (int fd : fd_)
+    if (fd >= 0)
+      close(fd);
+}
+
+void CounterSet::start() {
+  for (int fd : fd_)
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+Counts CounterSet::stop() {
+  for (int fd : fd_)
+    if (fd >= 0)
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  return read();
+}
+
+Counts CounterSet::read() const {
+  Counts c;
+
+  for (std::size_t e = 0; e < NUM_EVENTS; ++e) {
+    if (fd_[e] < 0)
+      continue;
+
+    // value, time_enabled, time_running
+    std::uint64_t buf[3];
+    if (::read(fd_[e], buf, sizeof(buf)) != ssize_t(sizeof(buf)))
+      continue;
+
+    // Multiplexed: extrapolate from the fraction of time it was counted
+    double scale = buf[2] > 0 ? double(buf[1]) / double(buf[2]) : 0.0;
+    c.value[e] = std::uint64_t(double(buf[0]) * scale + 0.5);
+    c.valid[e] = buf[2] > 0 || buf[1] == 0;
+  }
+
+  return c;
+}
+
+#else
+
+CounterSet::CounterSet(bool) { fd_.fill(-1); }
+CounterSet::~CounterSet() = default;
+void CounterSet::start() {}
+Counts CounterSet::stop() { return {}; }
+Counts CounterSet::read() const { return {}; }
+
+#endif
+
+bool CounterSet::available() const {
+  for (int fd : fd_)
+    if (fd >= 0)
+      return true;
+  return false;
+}
+
+// ================================================================
+// Per-phase totals
+// ================================================================
+namespace {
+
+struct PhaseTotals {
+  std::atomic<std::uint64_t> value[NUM_PHASES][NUM_EVENTS] = {};
+  std::atomic<bool> valid[NUM_PHASES][NUM_EVENTS] = {};
+};
+
+PhaseTotals &totals() {
+  static PhaseTotals t;
+  return t;
+}
+
+} // namespace
+
+std::array<Counts, NUM_PHASES> phase_counts() {
+  std::array<Counts, NUM_PHASES> out;
+  PhaseTotals &t = totals();
+
+  for (std::size_t p = 0; p < NUM_PHASES; ++p)
+    for (std::size_t e = 0; e < NUM_EVENTS; ++e) {
+      out[p].value[e] = t.value[p][e].load(std::memory_order_relaxed);
+      out[p].valid[e] = t.valid[p][e].load(std::memory_order_relaxed);
+    }
+  return out;
+}
+
+void reset_phase_counts() {
+  PhaseTotals &t = totals();
+
+  for (std::size_t p = 0; p < NUM_PHASES; ++p)
+    for (std::size_t e = 0; e < NUM_EVENTS; ++e) {
+      t.value[p][e].store(0, std::memory_order_relaxed);
+      t.valid[p][e].store(false, std::memory_order_relaxed);
+    }
+}
+
+#ifdef ATLAS_PERF_COUNTERS
+
+// Counters of the calling thread only, running for its lifetime
+static const CounterSet &thread_counters() {
+  thread_local CounterSet set(false);
+  thread_local bool started = (set.start(), true);
+  (void)started;
+  return set;
+}
+
+PhaseScope::PhaseScope(Phase p) : phase_(p), begin_(thread_counters().read()) {}
+
+PhaseScope::~PhaseScope() {
+  Counts end = thread_counters().read();
+  PhaseTotals &t = totals();
+  const std::size_t p = std::size_t(phase_);
+
+  for (std::size_t e = 0; e < NUM_EVENTS; ++e) {
+    if (!end.valid[e] || !begin_.valid[e])
+      continue;
+
+    std::uint64_t delta =
+        end.value[e] > begin_.value[e] ? end.value[e] - begin_.value[e] : 0;
+    t.value[p][e].fetch_add(delta, std::memory_order_relaxed);
+    t.valid[p][e].store(true, std::memory_order_relaxed);
+  }
+}
+
+#endif
+
+} // namespace gemm::perf
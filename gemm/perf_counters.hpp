@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Hardware performance counters (Linux perf_event_open).
+//
+// Every event is opened on its own, so a machine (or container, or
+// perf_event_paranoid level) that lacks some of them still reports the
+// rest; without perf support at all nothing is valid and every call is a
+// no-op. Events outnumbering the hardware counters are multiplexed by the
+// kernel and scaled by time_enabled / time_running.
+//
+// Library mode (-DATLAS_PERF_COUNTERS): the packed drivers additionally
+// attribute counts to GEMM phases (pack A, pack B, microkernel, edge
+// tiles), summed process-wide over all worker threads. Compiled out
+// otherwise.
+
+namespace gemm::perf {
+
+enum class Event {
+  Cycles,
+  Instructions,
+  L1DAccesses,
+  L1DMisses,
+  LLCAccesses,
+  LLCMisses,
+  DTLBMisses,
+  FPOps, // raw event from ATLAS_PERF_FP_EVENT (hex), no portable encoding
+  Count
+};
+
+constexpr std::size_t NUM_EVENTS = std::size_t(Event::Count);
+
+const char *event_name(Event e);
+
+// Counter values of one measurement; an invalid event reads as zero
+struct Counts {
+  std::array<std::uint64_t, NUM_EVENTS> value{};
+  std::array<bool, NUM_EVENTS> valid{};
+
+  std::uint64_t operator[](Event e) const { return value[std::size_t(e)]; }
+  bool has(Event e) const { return valid[std::size_t(e)]; }
+
+  Counts &operator+=(const Counts &o);
+
+  // Derived metrics: NaN when an input event is unavailable
+  double ipc() const;
+  double l1d_miss_rate() const;
+  double llc_miss_rate() const;
+  double dtlb_mpki() const; // dTLB misses per 1000 instructions
+
+  // FLOPs per cycle from the FP counter, or from `flops` (e.g. 2 M N K)
+  // when given
+  double flops_per_cycle(double flops = 0.0) const;
+};
+
+// One open counter set. inherit: also count threads created after
+// start() (the v6 workers) — their counts arrive when they are joined.
+class CounterSet {
+public:
+  explicit CounterSet(bool inherit = true);
+  ~CounterSet();
+
+  CounterSet(const CounterSet &) = delete;
+  CounterSet &operator=(const CounterSet &) = delete;
+
+  bool available() const; // at least one event opened
+
+  void start(); // reset and enable
+  Counts stop();
+  Counts read() const; // running totals since start()
+
+private:
+  std::array<int, NUM_EVENTS> fd_;
+};
+
+// Counts of one call of fn on the calling thread and its children
+template <class Fn> inline Counts count(const Fn &fn) {
+  CounterSet set;
+  set.start();
+  fn();
+  return set.stop();
+}
+
+// ================================================================
+// Per-phase attribution (library mode)
+// ================================================================
+enum class Phase { PackA, PackB, Microkernel, Edge, Count };
+
+constexpr std::size_t NUM_PHASES = std::size_t(Phase::Count);
+
+const char *phase_name(Phase p);
+
+// Process-wide totals per phase since the last reset (all zero / invalid
+// unless built with ATLAS_PERF_COUNTERS)
+std::array<Counts, NUM_PHASES> phase_counts();
+void reset_phase_counts();
+
+#ifdef ATLAS_PERF_COUNTERS
+
+// Counts between construction and destruction, added to the phase total
+// (per-thread counter set, opened on first use)
+class PhaseScope {
+public:
+  explicit PhaseScope(Phase p);
+  ~PhaseScope();
+
+  PhaseScope(const PhaseScope &) = delete;
+  PhaseScope &operator=(const PhaseScope &) = delete;
+
+private:
+  Phase phase_;
+  Counts begin_;
+};
+
+#else
+
+class PhaseScope {
+public:
+  explicit PhaseScope(Phase) {}
+};
+
+#endif
+
+} // namespace gemm::perf
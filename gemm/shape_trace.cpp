@@ -0,0 +1,131 @@
+#include "shape_trace.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace gemm::shape_trace {
+
+namespace {
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_bytes;
+};
+
+constexpr char MAGIC[8] = {'A', 'T', 'L', 'S', 'H', 'P', '1', '\0'};
+constexpr std::uint32_t VERSION = 1;
+
+// Records are batched and written under one lock (calls are >= microseconds)
+constexpr std::size_t BATCH = 4096;
+
+struct Writer {
+  std::mutex lock;
+  std::FILE *file = nullptr;
+  std::vector<Record> batch;
+};
+
+// Never destroyed: the atexit stop() may run after static destructors
+Writer &writer() {
+  static Writer *w = new Writer;
+  return *w;
+}
+
+void flush(Writer &w) {
+  if (w.file && !w.batch.empty())
+    std::fwrite(w.batch.data(), sizeof(Record), w.batch.size(), w.file);
+  w.batch.clear();
+}
+
+// ATLAS_SHAPE_TRACE=path: record the whole process
+[[maybe_unused]] const bool env_start = [] {
+  const char *path = std::getenv("ATLAS_SHAPE_TRACE");
+  return path && *path && start(path);
+}();
+
+} // namespace
+
+const char *entry_name(Entry e) {
+  switch (e) {
+  case Entry::V5:
+    return "v5";
+  case Entry::V6:
+    return "v6";
+  case Entry::Dispatch:
+    return "dispatch";
+  case Entry::Strassen:
+    return "strassen";
+  }
+  return "?";
+}
+
+bool start(const std::string &path) {
+  static std::once_flag exit_hook;
+  std::call_once(exit_hook, [] { std::atexit(stop); });
+
+  stop();
+
+  Writer &w = writer();
+  std::lock_guard<std::mutex> g(w.lock);
+
+  w.file = std::fopen(path.c_str(), "wb");
+  if (!w.file)
+    return false;
+
+  Header h;
+  std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.record_bytes = sizeof(Record);
+  std::fwrite(&h, sizeof(h), 1, w.file);
+
+  w.batch.reserve(BATCH);
+  detail::recording.store(true, std::memory_order_release);
+  return true;
+}
+
+void stop() {
+  detail::recording.store(false, std::memory_order_release);
+
+  Writer &w = writer();
+  std::lock_guard<std::mutex> g(w.lock);
+
+  flush(w);
+  if (w.file)
+    std::fclose(w.file);
+  w.file = nullptr;
+}
+
+void detail::append(const Record &r) {
+  Writer &w = writer();
+  std::lock_guard<std::mutex> g(w.lock);
+
+  if (!w.file)
+    return; // stopped while the call ran
+  w.batch.push_back(r);
+  if (w.batch.size() >= BATCH)
+    flush(w);
+}
+
+bool read(const std::string &path, std::vector<Record> &out) {
+  out.clear();
+
+  std::FILE *f = std::fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+
+  Header h;
+  bool ok = std::fread(&h, sizeof(h), 1, f) == 1 &&
+            std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+            h.version == VERSION && h.record_bytes == sizeof(Record);
+
+  Record r;
+  while (ok && std::fread(&r, sizeof(r), 1, f) == 1)
+    out.push_back(r);
+
+  std::fclose(f);
+  return ok;
+}
+
+} // namespace gemm::shape_trace
@@ -0,0 +1,99 @@
+#pragma once
+#include "kernel_config.hpp"
+#include "ticks.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Production shape capture: every call of the public v5 / v6 / dispatch /
+// Strassen entry points while recording appends one fixed-size record (shape,
+// leading dimensions, thread budget, duration) to a binary trace file.
+// benchmark_replay re-runs a trace against any kernel or block / thread
+// configuration.
+//
+// Off by default. Start with shape_trace::start(path) or by setting
+// ATLAS_SHAPE_TRACE=path in the environment (recorded until exit). When
+// off, an entry point pays one relaxed atomic load. Only the outermost
+// entry of a call is recorded (dispatch, not the v6 it routes to;
+// Strassen, not its base-case and peel v6 calls). The out-of-core driver
+// has no entry of its own and shows up as its per-slab v6 calls.
+//
+// File: 16-byte header (magic "ATLSHP1\0", version, record size), then
+// packed Records in call-completion order.
+
+namespace gemm::shape_trace {
+
+enum class Entry : std::uint8_t { V5, V6, Dispatch, Strassen };
+enum class DType : std::uint8_t { F32, F64 };
+
+const char *entry_name(Entry e);
+
+struct Record {
+  std::uint32_t M, N, K, lda, ldb, ldc;
+  std::uint16_t threads; // thread budget: v5 1, otherwise the workers
+  Entry entry;
+  DType dtype;
+  std::uint32_t reserved;
+  std::uint64_t time_ns;
+};
+
+static_assert(sizeof(Record) == 40, "trace records are written raw");
+
+// Truncates path; false when it cannot be opened (recording stays off)
+bool start(const std::string &path);
+// Flushes and closes the trace
+void stop();
+
+// Whole trace; false on a missing file or a bad header
+bool read(const std::string &path, std::vector<Record> &out);
+
+namespace detail {
+inline std::atomic<bool> recording{false};
+inline thread_local unsigned depth = 0;
+void append(const Record &r);
+} // namespace detail
+
+// Entry-point hook: records the call it spans
+class Scope {
+public:
+  Scope(Entry e, DType d, const GemmConfig &cfg, unsigned threads) {
+    if (!detail::recording.load(std::memory_order_relaxed))
+      return;
+
+    counted_ = true;
+    if (detail::depth++ > 0)
+      return; // nested entry
+
+    rec_ = {std::uint32_t(cfg.M),   std::uint32_t(cfg.N),
+            std::uint32_t(cfg.K),   std::uint32_t(cfg.lda),
+            std::uint32_t(cfg.ldb), std::uint32_t(cfg.ldc),
+            std::uint16_t(threads), e,
+            d,                      0,
+            0};
+    armed_ = true;
+    start_ = ticks();
+  }
+
+  ~Scope() {
+    if (armed_) {
+      rec_.time_ns = std::uint64_t(double(ticks() - start_) * 1e9 /
+                                   ticks_per_second());
+      detail::append(rec_);
+    }
+    if (counted_)
+      --detail::depth;
+  }
+
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+private:
+  Record rec_{};
+  std::uint64_t start_ = 0;
+  bool counted_ = false;
+  bool armed_ = false;
+};
+
+} // namespace gemm::shape_trace
@@ -0,0 +1,227 @@
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using index_t = std::size_t;
+
+// Below this much streamed data a single thread wins (no spawn / join)
+static constexpr index_t SKINNY_PARALLEL_BYTES = 256 * 1024;
+
+// ================================================================
+// fn(begin, end) over [0, total) in chunks of grain, claimed dynamically.
+// No workspace: the skinny kernels do not pack the streamed operand.
+// ================================================================
+template <class RangeFn>
+static void parallel_ranges(index_t total, index_t grain, index_t bytes,
+                            const RangeFn &fn) {
+  index_t chunks = (total + grain - 1) / grain;
+
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  num_threads = unsigned(std::min<index_t>(num_threads, chunks));
+
+  if (num_threads <= 1 || bytes < SKINNY_PARALLEL_BYTES) {
+    fn(index_t(0), total);
+    return;
+  }
+
+  std::atomic<index_t> next(0);
+
+  auto worker = [&]() {
+    while (true) {
+      index_t c = next.fetch_add(1);
+      if (c >= chunks)
+        break;
+      fn(c * grain, std::min(total, (c + 1) * grain));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+
+  for (unsigned t = 0; t < num_threads; ++t)
+    threads.emplace_back(worker);
+
+  for (auto &th : threads)
+    th.join();
+}
+
+// ================================================================
+// N <= 4: one pass over each row of A, NC dot products against the
+// columns of B (transposed once into Bt, K floats per column). Several
+// independent accumulators per column hide the FMA latency.
+// ================================================================
+template <int NC>
+static void skinny_n_rows(const float *A, const float *Bt, float *C,
+                          const GemmConfig &cfg, index_t i0, index_t i1) {
+  constexpr int U = NC == 1 ? 4 : 2; // accumulators per column
+  constexpr index_t STEP = 4 * U;
+
+  const index_t K = cfg.K;
+
+  for (index_t i = i0; i < i1; ++i) {
+    const float *a = A + i * cfg.lda;
+
+    float32x4_t acc[NC][U];
+    for (int n = 0; n < NC; ++n)
+      for (int u = 0; u < U; ++u)
+        acc[n][u] = vdupq_n_f32(0.0f);
+
+    index_t k = 0;
+    for (; k + STEP <= K; k += STEP) {
+      float32x4_t av[U];
+      for (int u = 0; u < U; ++u)
+        av[u] = vld1q_f32(a + k + 4 * u);
+
+      for (int n = 0; n < NC; ++n)
+        for (int u = 0; u < U; ++u)
+          acc[n][u] =
+              vfmaq_f32(acc[n][u], av[u], vld1q_f32(Bt + n * K + k + 4 * u));
+    }
+
+    for (int n = 0; n < NC; ++n) {
+      for (int u = 1; u < U; ++u)
+        acc[n][0] = vaddq_f32(acc[n][0], acc[n][u]);
+
+      float sum = vaddvq_f32(acc[n][0]);
+      for (index_t kt = k; kt < K; ++kt)
+        sum += a[kt] * Bt[n * K + kt];
+
+      C[i * cfg.ldc + n] += sum;
+    }
+  }
+}
+
+void gemm_skinny_n(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg) {
+  if (cfg.M == 0 || cfg.N == 0)
+    return;
+
+  // Columns of B made contiguous (N * K floats, read once per row)
+  std::vector<float> Bt(cfg.N * cfg.K);
+  for (index_t k = 0; k < cfg.K; ++k)
+    for (index_t n = 0; n < cfg.N; ++n)
+      Bt[n * cfg.K + k] = B[k * cfg.ldb + n];
+
+  // Groups of up to 4 columns per pass over the rows
+  auto rows = [&](index_t i0, index_t i1) {
+    for (index_t n = 0; n < cfg.N; n += 4) {
+      GemmConfig sub = cfg;
+      sub.N = std::min<index_t>(4, cfg.N - n);
+      const float *bt = Bt.data() + n * cfg.K;
+
+      switch (sub.N) {
+      case 1:
+        skinny_n_rows<1>(A, bt, C + n, sub, i0, i1);
+        break;
+      case 2:
+        skinny_n_rows<2>(A, bt, C + n, sub, i0, i1);
+        break;
+      case 3:
+        skinny_n_rows<3>(A, bt, C + n, sub, i0, i1);
+        break;
+      default:
+        skinny_n_rows<4>(A, bt, C + n, sub, i0, i1);
+        break;
+      }
+    }
+  };
+
+  parallel_ranges(cfg.M, 64, cfg.M * cfg.K * sizeof(float), rows);
+}
+
+// ================================================================
+// M <= 4: one pass over B. Each 16-column strip of C lives in MC x 4
+// registers for the whole K loop; every k touches one cache line of B.
+// ================================================================
+template <int MC>
+static void skinny_m_cols(const float *A, const float *B, float *C,
+                          const GemmConfig &cfg, index_t j0, index_t j1) {
+  constexpr index_t STRIP = 16;
+
+  index_t j = j0;
+  for (; j + STRIP <= j1; j += STRIP) {
+    float32x4_t acc[MC][4];
+    for (int i = 0; i < MC; ++i)
+      for (int v = 0; v < 4; ++v)
+        acc[i][v] = vdupq_n_f32(0.0f);
+
+    for (index_t k = 0; k < cfg.K; ++k) {
+      const float *b = B + k * cfg.ldb + j;
+      float32x4_t bv[4] = {vld1q_f32(b), vld1q_f32(b + 4), vld1q_f32(b + 8),
+                           vld1q_f32(b + 12)};
+
+      for (int i = 0; i < MC; ++i) {
+        float a = A[i * cfg.lda + k];
+        for (int v = 0; v < 4; ++v)
+          acc[i][v] = vfmaq_n_f32(acc[i][v], bv[v], a);
+      }
+    }
+
+    for (int i = 0; i < MC; ++i)
+      for (int v = 0; v < 4; ++v) {
+        float *c = C + i * cfg.ldc + j + 4 * v;
+        vst1q_f32(c, vaddq_f32(vld1q_f32(c), acc[i][v]));
+      }
+  }
+
+  // Column tail (< 16): scalar, still one pass over the strip of B
+  if (j < j1) {
+    float acc[MC][STRIP] = {};
+
+    for (index_t k = 0; k < cfg.K; ++k)
+      for (int i = 0; i < MC; ++i) {
+        float a = A[i * cfg.lda + k];
+        for (index_t jt = j; jt < j1; ++jt)
+          acc[i][jt - j] += a * B[k * cfg.ldb + jt];
+      }
+
+    for (int i = 0; i < MC; ++i)
+      for (index_t jt = j; jt < j1; ++jt)
+        C[i * cfg.ldc + jt] += acc[i][jt - j];
+  }
+}
+
+void gemm_skinny_m(const float *A, const float *B, float *C,
+                   const GemmConfig &cfg) {
+  if (cfg.N == 0)
+    return;
+
+  // Chunks of 256 columns: whole strips, enough of them to balance
+  auto cols = [&](index_t j0, index_t j1) {
+    for (index_t i = 0; i < cfg.M; i += 4) {
+      GemmConfig sub = cfg;
+      sub.M = std::min<index_t>(4, cfg.M - i);
+      const float *a = A + i * cfg.lda;
+      float *c = C + i * cfg.ldc;
+
+      switch (sub.M) {
+      case 1:
+        skinny_m_cols<1>(a, B, c, sub, j0, j1);
+        break;
+      case 2:
+        skinny_m_cols<2>(a, B, c, sub, j0, j1);
+        break;
+      case 3:
+        skinny_m_cols<3>(a, B, c, sub, j0, j1);
+        break;
+      default:
+        skinny_m_cols<4>(a, B, c, sub, j0, j1);
+        break;
+      }
+    }
+  };
+
+  parallel_ranges(cfg.N, 256, cfg.K * cfg.N * sizeof(float), cols);
+}
+
+} // namespace gemm
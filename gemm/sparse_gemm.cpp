@@ -0,0 +1,233 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// Rows [ii, ii + Mb) of C against block columns [c0, c1) of B
+struct SparseTile {
+  index_t ii, Mb;
+  index_t c0, c1;
+  index_t cost; // Mb * stored blocks: the multiply work of the tile
+};
+
+// ================================================================
+// A slab: rows [0, Mb) x one block row of K, row-major with stride bk,
+// zero padded to Mp rows (whole micro tiles) and to bk columns (K edge)
+// ================================================================
+static void pack_a_slab(float *dst, const float *A, index_t lda, index_t Mb,
+                        index_t Mp, index_t kw, index_t bk) {
+  if (kw == bk) {
+    pack_A(dst, A, int(Mb), int(bk), int(lda));
+  } else {
+    for (index_t i = 0; i < Mb; ++i) {
+      std::copy(A + i * lda, A + i * lda + kw, dst + i * bk);
+      std::fill(dst + i * bk + kw, dst + (i + 1) * bk, 0.0f);
+    }
+  }
+
+  std::fill(dst + Mb * bk, dst + Mp * bk, 0.0f);
+}
+
+// ================================================================
+// 8x8 tile of C += sum over stored blocks [nz0, nz1) of one block column:
+// the tile stays in registers across every block, only present blocks
+// are read. A: packed slabs of the K pass (slab floats apart, offset to
+// the tile's first row); q: column offset inside the block.
+// ================================================================
+static inline void sparse_kernel_8x8(const float *A, index_t slab,
+                                     index_t kb0, const BlockSparseMatrix &B,
+                                     index_t nz0, index_t nz1, index_t q,
+                                     float *C, index_t ldc, index_t mr,
+                                     index_t nr) {
+  const index_t bk = B.block_rows;
+  const index_t bn = B.block_cols;
+
+  float32x4_t c[8][2];
+  for (int i = 0; i < 8; ++i)
+    c[i][0] = c[i][1] = vdupq_n_f32(0.0f);
+
+  for (index_t nz = nz0; nz < nz1; ++nz) {
+    const float *a = A + (B.row_idx[nz] - kb0) * slab;
+    const float *b = B.block(int(nz)) + q;
+
+    for (index_t k = 0; k < bk; ++k) {
+      float32x4_t b0 = vld1q_f32(b + k * bn);
+      float32x4_t b1 = vld1q_f32(b + k * bn + 4);
+
+      for (int i = 0; i < 8; ++i) {
+        float32x4_t av = vdupq_n_f32(a[i * bk + k]);
+        c[i][0] = vfmaq_f32(c[i][0], b0, av);
+        c[i][1] = vfmaq_f32(c[i][1], b1, av);
+      }
+    }
+  }
+
+  if (mr == 8 && nr == 8) {
+    for (int i = 0; i < 8; ++i) {
+      float *ci = C + i * ldc;
+      vst1q_f32(ci, vaddq_f32(vld1q_f32(ci), c[i][0]));
+      vst1q_f32(ci + 4, vaddq_f32(vld1q_f32(ci + 4), c[i][1]));
+    }
+    return;
+  }
+
+  // Edge tile: padded rows / columns are computed and dropped
+  float tmp[8 * 8];
+  for (int i = 0; i < 8; ++i) {
+    vst1q_f32(tmp + i * 8, c[i][0]);
+    vst1q_f32(tmp + i * 8 + 4, c[i][1]);
+  }
+
+  for (index_t i = 0; i < mr; ++i)
+    for (index_t j = 0; j < nr; ++j)
+      C[i * ldc + j] += tmp[i * 8 + j];
+}
+
+// ================================================================
+// One tile: K walked in passes of up to BK; each pass packs only the A
+// slabs some block column of the tile uses, then every column sweeps
+// its stored blocks of the pass.
+// ================================================================
+static void sparse_tile(Workspace &ws, const float *A,
+                        const BlockSparseMatrix &B, float *C,
+                        const GemmConfig &cfg, const SparseTile &t) {
+  constexpr index_t BK = config::DEFAULT_BK;
+  constexpr index_t MR = config::MR;
+  constexpr index_t NR = config::NR;
+
+  const index_t bk = B.block_rows;
+  const index_t bn = B.block_cols;
+  const index_t Mp = (t.Mb + MR - 1) / MR * MR;
+  const index_t slab = Mp * bk;
+  const index_t kblocks = B.block_row_count();
+  const index_t pass = std::max<index_t>(1, BK / bk);
+
+  // Next unprocessed stored block of each column
+  std::vector<index_t> cursor(t.c1 - t.c0);
+  for (index_t c = t.c0; c < t.c1; ++c)
+    cursor[c - t.c0] = B.col_ptr[c];
+
+  std::vector<char> used(pass);
+
+  for (index_t kb0 = 0; kb0 < kblocks; kb0 += pass) {
+    index_t kb1 = std::min(kblocks, kb0 + pass);
+
+    std::fill(used.begin(), used.end(), 0);
+    for (index_t c = t.c0; c < t.c1; ++c)
+      for (index_t nz = cursor[c - t.c0];
+           nz < index_t(B.col_ptr[c + 1]) && index_t(B.row_idx[nz]) < kb1;
+           ++nz)
+        used[B.row_idx[nz] - kb0] = 1;
+
+    for (index_t s = 0; s < kb1 - kb0; ++s) {
+      if (!used[s])
+        continue;
+      index_t k0 = (kb0 + s) * bk;
+      pack_a_slab(ws.packA() + s * slab, A + t.ii * cfg.lda + k0, cfg.lda,
+                  t.Mb, Mp, std::min(bk, cfg.K - k0), bk);
+    }
+
+    for (index_t c = t.c0; c < t.c1; ++c) {
+      index_t nz0 = cursor[c - t.c0], nz1 = nz0;
+      while (nz1 < index_t(B.col_ptr[c + 1]) &&
+             index_t(B.row_idx[nz1]) < kb1)
+        ++nz1;
+      cursor[c - t.c0] = nz1;
+
+      if (nz0 == nz1)
+        continue;
+
+      for (index_t q = 0; q < bn && c * bn + q < cfg.N; q += NR) {
+        index_t j = c * bn + q;
+        index_t nr = std::min(NR, cfg.N - j);
+
+        for (index_t i = 0; i < t.Mb; i += MR)
+          sparse_kernel_8x8(ws.packA() + i * bk, slab, kb0, B, nz0, nz1, q,
+                            C + (t.ii + i) * cfg.ldc + j, cfg.ldc,
+                            std::min(MR, t.Mb - i), nr);
+      }
+    }
+  }
+}
+
+// ================================================================
+// Tiles balanced by stored blocks, not by dense size: block columns are
+// cut into groups of about equal block count (at most BN columns wide),
+// empty groups are dropped, and the most expensive tiles go first.
+// ================================================================
+static std::vector<SparseTile> build_tiles(const BlockSparseMatrix &B,
+                                           index_t M) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  const index_t bcols = B.block_col_count();
+  const index_t row_blocks = (M + BM - 1) / BM;
+  const index_t max_width = std::max<index_t>(1, BN / B.block_cols);
+
+  index_t groups = std::max<index_t>(1, 4 * num_threads / row_blocks);
+  index_t target = std::max<index_t>(1, B.nnz_blocks() / groups);
+
+  std::vector<SparseTile> tiles;
+
+  for (index_t c0 = 0; c0 < bcols;) {
+    index_t c1 = c0, nnz = 0;
+    while (c1 < bcols && c1 - c0 < max_width && nnz < target) {
+      nnz += B.col_ptr[c1 + 1] - B.col_ptr[c1];
+      ++c1;
+    }
+
+    if (nnz > 0)
+      for (index_t ii = 0; ii < M; ii += BM) {
+        index_t Mb = std::min(BM, M - ii);
+        tiles.push_back({ii, Mb, c0, c1, Mb * nnz});
+      }
+
+    c0 = c1;
+  }
+
+  std::stable_sort(tiles.begin(), tiles.end(),
+                   [](const SparseTile &a, const SparseTile &b) {
+                     return a.cost > b.cost;
+                   });
+  return tiles;
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_block_sparse(const float *A, const BlockSparseMatrix &B, float *C,
+                       const GemmConfig &cfg) {
+  // Stored blocks are read in NR-wide vectors and packed against BK-deep
+  // A slabs: any other geometry (or a B of another shape) would overrun
+  if (B.block_cols <= 0 || B.block_cols % int(config::NR) != 0 ||
+      B.block_rows <= 0 || B.block_rows > int(config::DEFAULT_BK) ||
+      index_t(B.rows) != cfg.K || index_t(B.cols) != cfg.N)
+    return;
+
+  if (cfg.M == 0 || B.nnz_blocks() == 0)
+    return;
+
+  std::vector<SparseTile> tiles = build_tiles(B, cfg.M);
+
+  detail::parallel_tiles(tiles.size(), [&](Workspace &ws, index_t id) {
+    sparse_tile(ws, A, B, C, cfg, tiles[id]);
+  });
+}
+
+} // namespace gemm
@@ -0,0 +1,182 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+#include "shape_trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// coef * block (r, c) of the 2^L x 2^L grid of a matrix
+struct GridTerm {
+  int r, c;
+  float coef;
+};
+
+// One base GEMM: (sum a) * (sum b), added into every c term
+struct StrassenProduct {
+  std::vector<GridTerm> a, b, c;
+};
+
+// ================================================================
+// Classic Strassen products on 2 x 2 quadrants. Every operand is a
+// combination of at most two quadrants, so the additions fold into
+// packing; Winograd's variant saves additions only by sharing
+// temporaries, which fused packing does not have.
+// ================================================================
+static std::vector<StrassenProduct> base_products() {
+  return {
+      // M1 = (A00 + A11)(B00 + B11)      C00 += M1, C11 += M1
+      {{{0, 0, 1}, {1, 1, 1}}, {{0, 0, 1}, {1, 1, 1}}, {{0, 0, 1}, {1, 1, 1}}},
+      // M2 = (A10 + A11) B00              C10 += M2, C11 -= M2
+      {{{1, 0, 1}, {1, 1, 1}}, {{0, 0, 1}}, {{1, 0, 1}, {1, 1, -1}}},
+      // M3 = A00 (B01 - B11)              C01 += M3, C11 += M3
+      {{{0, 0, 1}}, {{0, 1, 1}, {1, 1, -1}}, {{0, 1, 1}, {1, 1, 1}}},
+      // M4 = A11 (B10 - B00)              C00 += M4, C10 += M4
+      {{{1, 1, 1}}, {{1, 0, 1}, {0, 0, -1}}, {{0, 0, 1}, {1, 0, 1}}},
+      // M5 = (A00 + A01) B11              C00 -= M5, C01 += M5
+      {{{0, 0, 1}, {0, 1, 1}}, {{1, 1, 1}}, {{0, 0, -1}, {0, 1, 1}}},
+      // M6 = (A10 - A00)(B00 + B01)      C11 += M6
+      {{{1, 0, 1}, {0, 0, -1}}, {{0, 0, 1}, {0, 1, 1}}, {{1, 1, 1}}},
+      // M7 = (A01 - A11)(B10 + B11)      C00 += M7
+      {{{0, 1, 1}, {1, 1, -1}}, {{1, 0, 1}, {1, 1, 1}}, {{0, 0, 1}}},
+  };
+}
+
+// Outer quadrant terms x inner (finer grid) terms
+static std::vector<GridTerm> compose(const std::vector<GridTerm> &outer,
+                                     const std::vector<GridTerm> &inner,
+                                     int inner_grid) {
+  std::vector<GridTerm> out;
+  for (const GridTerm &o : outer)
+    for (const GridTerm &i : inner)
+      out.push_back({o.r * inner_grid + i.r, o.c * inner_grid + i.c,
+                     o.coef * i.coef});
+  return out;
+}
+
+// The 7^levels products of a levels-deep recursion, unrolled
+static std::vector<StrassenProduct> strassen_products(int levels) {
+  std::vector<StrassenProduct> products = {{{{0, 0, 1}}, {{0, 0, 1}},
+                                            {{0, 0, 1}}}};
+  int grid = 1;
+
+  for (int l = 0; l < levels; ++l) {
+    std::vector<StrassenProduct> next;
+    for (const StrassenProduct &o : base_products())
+      for (const StrassenProduct &i : products)
+        next.push_back({compose(o.a, i.a, grid), compose(o.b, i.b, grid),
+                        compose(o.c, i.c, grid)});
+    products = std::move(next);
+    grid *= 2;
+  }
+
+  return products;
+}
+
+// ================================================================
+// Plan: as many levels as keep every sub-problem >= crossover
+// ================================================================
+StrassenReport strassen_plan(const GemmConfig &cfg, index_t crossover) {
+  StrassenReport rep;
+
+  index_t smallest = std::min({cfg.M, cfg.N, cfg.K});
+  crossover = std::max<index_t>(crossover, 1);
+
+  while (rep.levels < config::STRASSEN_MAX_LEVELS &&
+         (smallest >> (rep.levels + 1)) >= crossover)
+    ++rep.levels;
+
+  double n = double(cfg.K);
+  double n0 = n / double(1 << rep.levels);
+
+  rep.products = index_t(std::pow(7.0, rep.levels));
+  rep.flop_ratio = std::pow(7.0 / 8.0, rep.levels);
+  rep.error_factor =
+      std::pow(12.0, rep.levels) * (n0 * n0 + 5.0 * n0) - 5.0 * n;
+  rep.conventional_factor = n * n;
+  return rep;
+}
+
+// ================================================================
+// Public API
+// ================================================================
+StrassenReport gemm_strassen(const float *A, const float *B, float *C,
+                             const GemmConfig &cfg, index_t crossover) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t BN = config::DEFAULT_BN;
+
+  shape_trace::Scope record(shape_trace::Entry::Strassen,
+                            shape_trace::DType::F32, cfg,
+                            std::thread::hardware_concurrency());
+
+  StrassenReport rep = strassen_plan(cfg, crossover);
+
+  if (rep.levels == 0) {
+    gemm_v6_parallel(A, B, C, cfg);
+    return rep;
+  }
+
+  // Core: the largest multiple of the grid in every dimension
+  const index_t grid = index_t(1) << rep.levels;
+  const index_t m = cfg.M / grid, n = cfg.N / grid, k = cfg.K / grid;
+
+  for (const StrassenProduct &p : strassen_products(rep.levels)) {
+    detail::parallel_blocks(
+        m, n,
+        [&](Workspace &ws, index_t ii, index_t jj, index_t Mb, index_t Nb) {
+          // Operands of this tile: grid blocks offset by (ii, jj)
+          detail::LinearOperand a{}, b{};
+          a.terms = int(p.a.size());
+          b.terms = int(p.b.size());
+
+          for (int t = 0; t < a.terms; ++t) {
+            a.src[t] = A + (p.a[t].r * m + ii) * cfg.lda + p.a[t].c * k;
+            a.coef[t] = p.a[t].coef;
+          }
+          for (int t = 0; t < b.terms; ++t) {
+            b.src[t] = B + p.b[t].r * k * cfg.ldb + p.b[t].c * n + jj;
+            b.coef[t] = p.b[t].coef;
+          }
+
+          // Product tile in scratch, then scattered into its C blocks
+          float *T = ws.scratch();
+          GemmConfig local{Mb, Nb, k, cfg.lda, cfg.ldb, Nb};
+          detail::compute_block(ws, &a, &b, T, local, 0, 0, Mb, Nb,
+                                epilogue::Identity{}, false);
+
+          for (const GridTerm &c : p.c) {
+            float *dst = C + (c.r * m + ii) * cfg.ldc + c.c * n + jj;
+            for (index_t i = 0; i < Mb; ++i)
+              for (index_t j = 0; j < Nb; ++j)
+                dst[i * cfg.ldc + j] += c.coef * T[i * Nb + j];
+          }
+        },
+        BM * BN * sizeof(float));
+  }
+
+  // Peel what the grid did not cover with the conventional kernel
+  const index_t Mc = m * grid, Nc = n * grid, Kc = k * grid;
+
+  if (Kc < cfg.K)
+    gemm_v6_parallel(A + Kc, B + Kc * cfg.ldb, C,
+                     {Mc, Nc, cfg.K - Kc, cfg.lda, cfg.ldb, cfg.ldc});
+  if (Nc < cfg.N)
+    gemm_v6_parallel(A, B + Nc, C + Nc,
+                     {Mc, cfg.N - Nc, cfg.K, cfg.lda, cfg.ldb, cfg.ldc});
+  if (Mc < cfg.M)
+    gemm_v6_parallel(A + Mc * cfg.lda, B, C + Mc * cfg.ldc,
+                     {cfg.M - Mc, cfg.N, cfg.K, cfg.lda, cfg.ldb, cfg.ldc});
+
+  return rep;
+}
+
+} // namespace gemm
@@ -0,0 +1,173 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// One C block of the stored triangle
+struct TriangleTile {
+  index_t ii, jj;
+  index_t Mb, Nb;
+};
+
+static bool in_triangle(Triangle uplo, index_t row, index_t col) {
+  return uplo == Triangle::Lower ? col <= row : col >= row;
+}
+
+// ================================================================
+// Diagonal block: C[d:d+Nb, d:d+Nb] += X * Y^T on the stored triangle.
+// Micro tiles fully inside the triangle accumulate in place; the ones on
+// the diagonal are computed into a register-sized tile and added under
+// a mask; the ones outside are skipped.
+// ================================================================
+static void diag_block(Workspace &ws, const float *X, const float *Y,
+                       float *C, const GemmConfig &g, Triangle uplo,
+                       index_t d, index_t Nb) {
+  constexpr index_t BK = config::DEFAULT_BK;
+  constexpr index_t MR = config::MR;
+  constexpr index_t NR = config::NR;
+  static_assert(MR == NR, "diagonal micro tiles must be square");
+
+  const epilogue::Identity ep;
+
+  for (index_t kk = 0; kk < g.K; kk += BK) {
+    index_t Kb = std::min(BK, g.K - kk);
+
+    pack_A(ws.packA(), X + d * g.lda + kk, Nb, Kb, g.lda);
+    pack_B_transposed(ws.packB(), Y + d * g.ldb + kk, Kb, Nb, g.ldb);
+
+    for (index_t i = 0; i < Nb; i += MR) {
+      for (index_t j = 0; j < Nb; j += NR) {
+
+        if (i != j && !in_triangle(uplo, i, j))
+          continue;
+
+        index_t mr = std::min(MR, Nb - i);
+        index_t nr = std::min(NR, Nb - j);
+
+        const float *aptr = ws.packA() + i * Kb;
+        const float *bptr = ws.packB() + j;
+        float *tile = C + (d + i) * g.ldc + d + j;
+
+        if (i != j) {
+          if (mr == MR && nr == NR)
+            detail::microkernel_8x8(aptr, bptr, Kb, Nb, tile, g.ldc, tile,
+                                    g.ldc, false, ep, 0, 0);
+          else
+            detail::edge_kernel(aptr, bptr, mr, nr, Kb, Nb, tile, g.ldc, tile,
+                                g.ldc, false, ep, 0, 0);
+          continue;
+        }
+
+        // Masked kernel for the micro tile on the diagonal
+        float tmp[MR * NR];
+        const float *none = nullptr;
+
+        if (mr == MR && nr == NR)
+          detail::microkernel_8x8(aptr, bptr, Kb, Nb, none, 0, tmp, NR, false,
+                                  ep, 0, 0);
+        else
+          detail::edge_kernel(aptr, bptr, mr, nr, Kb, Nb, none, 0, tmp, NR,
+                              false, ep, 0, 0);
+
+        for (index_t r = 0; r < mr; ++r)
+          for (index_t c = 0; c < nr; ++c)
+            if (in_triangle(uplo, r, c))
+              tile[r * g.ldc + c] += tmp[r * NR + c];
+      }
+    }
+  }
+}
+
+// ================================================================
+// Tile set of the triangle: off-diagonal blocks first, the (half as
+// expensive) diagonal blocks last so they fill the tail of the schedule
+// ================================================================
+static std::vector<TriangleTile> build_tiles(index_t N, Triangle uplo,
+                                             index_t tile) {
+  std::vector<TriangleTile> off, diag;
+
+  for (index_t ii = 0; ii < N; ii += tile) {
+    for (index_t jj = 0; jj < N; jj += tile) {
+      if (!in_triangle(uplo, ii, jj))
+        continue;
+
+      TriangleTile t{ii, jj, std::min(tile, N - ii), std::min(tile, N - jj)};
+      (ii == jj ? diag : off).push_back(t);
+    }
+  }
+
+  off.insert(off.end(), diag.begin(), diag.end());
+  return off;
+}
+
+// C += sum over (X, Y) of X * Y^T on the stored triangle
+static void rank_update(const float *A, const float *B, float *C,
+                        const SyrkConfig &cfg, bool two) {
+  constexpr index_t BM = config::DEFAULT_BM;
+  constexpr index_t MR = config::MR;
+
+  if (cfg.N == 0 || cfg.K == 0)
+    return;
+
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  // Same grain shrinking as the grouped GEMM: enough tiles for every core
+  index_t tile = BM;
+  std::vector<TriangleTile> tiles = build_tiles(cfg.N, cfg.uplo, tile);
+
+  while (tiles.size() < 4 * index_t(num_threads) && tile > 4 * MR) {
+    tile /= 2;
+    tiles = build_tiles(cfg.N, cfg.uplo, tile);
+  }
+
+  // (X, Y) = (A, B) and, for SYR2K, (B, A)
+  GemmConfig g1{cfg.N, cfg.N, cfg.K, cfg.lda, cfg.ldb, cfg.ldc};
+  GemmConfig g2{cfg.N, cfg.N, cfg.K, cfg.ldb, cfg.lda, cfg.ldc};
+  detail::TransposedOperand Bt{B}, At{A};
+
+  detail::parallel_tiles(tiles.size(), [&](Workspace &ws, index_t tile_id) {
+    const TriangleTile &t = tiles[tile_id];
+
+    if (t.ii == t.jj) {
+      diag_block(ws, A, B, C, g1, cfg.uplo, t.ii, t.Mb);
+      if (two)
+        diag_block(ws, B, A, C, g2, cfg.uplo, t.ii, t.Mb);
+      return;
+    }
+
+    detail::compute_block(ws, A, &Bt, C, g1, t.ii, t.jj, t.Mb, t.Nb,
+                          epilogue::Identity{}, true);
+    if (two)
+      detail::compute_block(ws, B, &At, C, g2, t.ii, t.jj, t.Mb, t.Nb,
+                            epilogue::Identity{}, true);
+  });
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_syrk(const float *A, float *C, const SyrkConfig &cfg) {
+  SyrkConfig c = cfg;
+  c.ldb = cfg.lda;
+  rank_update(A, A, C, c, false);
+}
+
+void gemm_syr2k(const float *A, const float *B, float *C,
+                const SyrkConfig &cfg) {
+  rank_update(A, B, C, cfg, true);
+}
+
+} // namespace gemm
@@ -0,0 +1,30 @@
+#include "ticks.hpp"
+
+#include <chrono>
+
+namespace gemm {
+
+double ticks_per_second() {
+#if defined(__aarch64__)
+  std::uint64_t f;
+  asm volatile("mrs %0, cntfrq_el0" : "=r"(f));
+  return double(f);
+#elif defined(__x86_64__)
+  // TSC rate against steady_clock over ~10 ms, once
+  static const double rate = [] {
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+    std::uint64_t c0 = ticks();
+    while (clock::now() - t0 < std::chrono::milliseconds(10)) {
+    }
+    std::uint64_t c1 = ticks();
+    double s = std::chrono::duration<double>(clock::now() - t0).count();
+    return double(c1 - c0) / s;
+  }();
+  return rate;
+#else
+  return 1e9;
+#endif
+}
+
+} // namespace gemm
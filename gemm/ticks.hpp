@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+// Cheapest monotonic counter of the target, for the instrumentation and
+// the tracer: CNTVCT_EL0 on AArch64 (24 MHz on Apple M-series, not core
+// cycles), the TSC on x86-64, steady_clock nanoseconds elsewhere.
+
+namespace gemm {
+
+inline std::uint64_t ticks() {
+#if defined(__aarch64__)
+  std::uint64_t t;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+#elif defined(__x86_64__)
+  return __rdtsc();
+#else
+  return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count());
+#endif
+}
+
+double ticks_per_second();
+
+} // namespace gemm
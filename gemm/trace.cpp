@@ -0,0 +1,216 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace gemm::trace {
+
+const char *name(Name n) {
+  switch (n) {
+  case Name::Tile:
+    return "tile";
+  case Name::Setup:
+    return "setup";
+  case Name::Call:
+    return "gemm";
+  case Name::Count:
+    return "?";
+  default:
+    return perf::phase_name(perf::Phase(n));
+  }
+}
+
+namespace {
+
+struct Event {
+  std::uint64_t begin, end;
+  std::uint32_t tid, arg;
+  Name name;
+};
+
+// Single writer (the owning thread); read only between calls
+struct Ring {
+  std::vector<Event> events;
+  std::atomic<std::uint64_t> head{0};
+
+  void push(const Event &e) {
+    std::uint64_t h = head.load(std::memory_order_relaxed);
+    events[h & (events.size() - 1)] = e;
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  std::size_t held() const {
+    return std::size_t(std::min<std::uint64_t>(
+        head.load(std::memory_order_acquire), events.size()));
+  }
+};
+
+struct Pool {
+  std::mutex lock;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::vector<Ring *> free;
+  std::size_t capacity = std::size_t(1) << 16;
+  std::atomic<std::uint32_t> next_tid{1};
+};
+
+// Never destroyed: threads may hand rings back during shutdown
+Pool &pool() {
+  static Pool *p = new Pool;
+  return *p;
+}
+
+} // namespace
+
+void start(std::size_t events_per_thread) {
+  Pool &p = pool();
+  std::lock_guard<std::mutex> g(p.lock);
+
+  std::size_t cap = 1;
+  while (cap < std::max<std::size_t>(events_per_thread, 2))
+    cap *= 2;
+  p.capacity = cap;
+
+  for (auto &r : p.rings) {
+    r->events.assign(cap, Event{});
+    r->head.store(0, std::memory_order_relaxed);
+  }
+
+#ifdef ATLAS_TRACE
+  detail::active.store(true, std::memory_order_release);
+#endif
+}
+
+void stop() {
+#ifdef ATLAS_TRACE
+  detail::active.store(false, std::memory_order_release);
+#endif
+}
+
+void resume() {
+#ifdef ATLAS_TRACE
+  detail::active.store(true, std::memory_order_release);
+#endif
+}
+
+std::size_t recorded() {
+  Pool &p = pool();
+  std::lock_guard<std::mutex> g(p.lock);
+
+  std::size_t n = 0;
+  for (auto &r : p.rings)
+    n += r->held();
+  return n;
+}
+
+std::size_t dropped() {
+  Pool &p = pool();
+  std::lock_guard<std::mutex> g(p.lock);
+
+  std::size_t n = 0;
+  for (auto &r : p.rings)
+    n += std::size_t(r->head.load(std::memory_order_acquire)) - r->held();
+  return n;
+}
+
+void write_chrome_json(std::ostream &os) {
+  std::vector<Event> all;
+  {
+    Pool &p = pool();
+    std::lock_guard<std::mutex> g(p.lock);
+
+    for (auto &r : p.rings) {
+      std::size_t n = r->held();
+      std::uint64_t h = r->head.load(std::memory_order_acquire);
+      for (std::uint64_t i = h - n; i < h; ++i)
+        all.push_back(r->events[i & (r->events.size() - 1)]);
+    }
+  }
+
+  std::sort(all.begin(), all.end(), [](const Event &a, const Event &b) {
+    return a.begin < b.begin;
+  });
+
+  const double us = 1e6 / ticks_per_second();
+  const std::uint64_t t0 = all.empty() ? 0 : all.front().begin;
+
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+  for (std::size_t i = 0; i < all.size(); ++i) {
+    const Event &e = all[i];
+    os << (i ? ",\n" : "\n") << "{\"name\": \"" << name(e.name)
+       << "\", \"cat\": \"gemm\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+       << e.tid << ", \"ts\": " << double(e.begin - t0) * us
+       << ", \"dur\": " << double(e.end - e.begin) * us;
+    if (e.name == Name::Tile || e.name == Name::Call)
+      os << ", \"args\": {\"" << (e.name == Name::Tile ? "tile" : "tiles")
+         << "\": " << e.arg << "}";
+    os << "}";
+  }
+
+  os << "\n]}\n";
+  os.unsetf(std::ios::floatfield);
+}
+
+bool write_chrome_json(const std::string &path) {
+  std::ofstream out(path);
+  if (!out)
+    return false;
+  write_chrome_json(out);
+  return bool(out);
+}
+
+#ifdef ATLAS_TRACE
+
+namespace {
+
+// The calling thread's ring, taken from the pool on first use and handed
+// back at thread exit
+struct Holder {
+  Ring *ring = nullptr;
+  std::uint32_t tid = 0;
+
+  Ring &get() {
+    if (!ring) {
+      Pool &p = pool();
+      std::lock_guard<std::mutex> g(p.lock);
+
+      if (!p.free.empty()) {
+        ring = p.free.back();
+        p.free.pop_back();
+      } else {
+        p.rings.push_back(std::make_unique<Ring>());
+        ring = p.rings.back().get();
+        ring->events.assign(p.capacity, Event{});
+      }
+      tid = p.next_tid.fetch_add(1, std::memory_order_relaxed);
+    }
+    return *ring;
+  }
+
+  ~Holder() {
+    if (ring) {
+      Pool &p = pool();
+      std::lock_guard<std::mutex> g(p.lock);
+      p.free.push_back(ring);
+    }
+  }
+};
+
+} // namespace
+
+void detail::record(Name n, std::uint64_t begin, std::uint64_t end,
+                    std::uint32_t arg) {
+  thread_local Holder holder;
+  Ring &r = holder.get();
+  r.push({begin, end, holder.tid, arg, n});
+}
+
+#endif
+
+} // namespace gemm::trace
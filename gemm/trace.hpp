@@ -0,0 +1,92 @@
+#pragma once
+#include "perf_counters.hpp"
+#include "ticks.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Timeline tracer of the GEMM drivers (-DATLAS_TRACE): spans of every
+// parallel call, worker setup, tile and packing / microkernel phase, one
+// event per span (begin and end ticks) in per-thread ring buffers.
+// Writers never lock: a buffer belongs to one thread at a time (pooled,
+// handed back when the thread exits), and a full ring overwrites its
+// oldest events. Dumped as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev).
+//
+// start() / stop() / write_chrome_json() must not overlap a traced GEMM
+// call. Without ATLAS_TRACE spans are empty objects and nothing is
+// recorded.
+
+namespace gemm::trace {
+
+// Phases first, in perf::Phase order
+enum class Name : std::uint8_t {
+  PackA,
+  PackB,
+  Microkernel,
+  Edge,
+  Tile,
+  Setup, // worker thread start and workspace allocation
+  Call,
+  Count
+};
+
+const char *name(Name n);
+
+// Clears every buffer and starts recording (events_per_thread rounded up
+// to a power of two)
+void start(std::size_t events_per_thread = std::size_t(1) << 16);
+void stop();
+void resume(); // continue after stop() without clearing
+
+std::size_t recorded(); // events held in the buffers
+std::size_t dropped();  // events overwritten by full rings
+
+// Chrome trace JSON ("X" complete events, microseconds from the first
+// event); false when the file cannot be written
+void write_chrome_json(std::ostream &os);
+bool write_chrome_json(const std::string &path);
+
+#ifdef ATLAS_TRACE
+
+namespace detail {
+inline std::atomic<bool> active{false};
+void record(Name n, std::uint64_t begin, std::uint64_t end,
+            std::uint32_t arg);
+} // namespace detail
+
+class Span {
+public:
+  explicit Span(Name n, std::uint32_t arg = 0)
+      : begin_(detail::active.load(std::memory_order_relaxed) ? ticks() : 0),
+        arg_(arg), name_(n) {}
+  explicit Span(perf::Phase p) : Span(Name(p)) {}
+
+  ~Span() {
+    if (begin_)
+      detail::record(name_, begin_, ticks(), arg_);
+  }
+
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+
+private:
+  std::uint64_t begin_;
+  std::uint32_t arg_;
+  Name name_;
+};
+
+#else
+
+class Span {
+public:
+  explicit Span(Name, std::uint32_t = 0) {}
+  explicit Span(perf::Phase) {}
+};
+
+#endif
+
+} // namespace gemm::trace
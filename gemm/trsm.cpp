@@ -0,0 +1,191 @@
+#include "../atlas_memory/include/atlas_memory/config_m2.hpp"
+#include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "kernel_config.hpp"
+#include "kernels.hpp"
+#include "packed_block.hpp"
+
+#include <algorithm>
+#include <arm_neon.h>
+#include <thread>
+
+namespace gemm {
+
+using namespace atlas_memory;
+using index_t = std::size_t;
+
+// Diagonal block size: only these nb x nb triangles run outside the
+// packed GEMM (a fraction nb / M of the flops)
+static constexpr index_t TRIANGLE_NB = 128;
+
+// ================================================================
+// Row kernels of the diagonal blocks (one row of a column strip)
+// ================================================================
+
+// y += a * x
+static inline void axpy_row(float *y, const float *x, float a, index_t w) {
+  index_t j = 0;
+  for (; j + 8 <= w; j += 8) {
+    vst1q_f32(y + j, vfmaq_n_f32(vld1q_f32(y + j), vld1q_f32(x + j), a));
+    vst1q_f32(y + j + 4,
+              vfmaq_n_f32(vld1q_f32(y + j + 4), vld1q_f32(x + j + 4), a));
+  }
+  for (; j < w; ++j)
+    y[j] += a * x[j];
+}
+
+// y *= s
+static inline void scale_row(float *y, float s, index_t w) {
+  index_t j = 0;
+  for (; j + 4 <= w; j += 4)
+    vst1q_f32(y + j, vmulq_n_f32(vld1q_f32(y + j), s));
+  for (; j < w; ++j)
+    y[j] *= s;
+}
+
+// ================================================================
+// Triangular microkernels on an nb x nb diagonal block of A against an
+// nb x w strip of B (in place)
+// ================================================================
+
+// X = T^-1 X
+static void diag_solve(const float *T, index_t ldt, float *X, index_t ldx,
+                       index_t nb, index_t w, const TriangularConfig &cfg) {
+  bool lower = cfg.uplo == Triangle::Lower;
+
+  for (index_t s = 0; s < nb; ++s) {
+    index_t i = lower ? s : nb - 1 - s;
+    float *xi = X + i * ldx;
+
+    index_t p0 = lower ? 0 : i + 1;
+    index_t p1 = lower ? i : nb;
+    for (index_t p = p0; p < p1; ++p)
+      axpy_row(xi, X + p * ldx, -T[i * ldt + p], w);
+
+    if (!cfg.unit_diag)
+      scale_row(xi, 1.0f / T[i * ldt + i], w);
+  }
+}
+
+// X = T X (rows are updated in the order that keeps their inputs intact)
+static void diag_multiply(const float *T, index_t ldt, float *X, index_t ldx,
+                          index_t nb, index_t w, const TriangularConfig &cfg) {
+  bool lower = cfg.uplo == Triangle::Lower;
+
+  for (index_t s = 0; s < nb; ++s) {
+    index_t i = lower ? nb - 1 - s : s;
+    float *xi = X + i * ldx;
+
+    if (!cfg.unit_diag)
+      scale_row(xi, T[i * ldt + i], w);
+
+    index_t p0 = lower ? 0 : i + 1;
+    index_t p1 = lower ? i : nb;
+    for (index_t p = p0; p < p1; ++p)
+      axpy_row(xi, X + p * ldx, T[i * ldt + p], w);
+  }
+}
+
+// ================================================================
+// C[r0:r1, strip] += A_op[r0:r1, k0:k0+K] * X[0:K, strip] on the packed
+// GEMM, BM rows at a time
+// ================================================================
+template <class TA>
+static void block_update(Workspace &ws, const TA *A_op, const float *X,
+                         float *C, const TriangularConfig &cfg, index_t r0,
+                         index_t r1, index_t K, index_t w) {
+  constexpr index_t BM = config::DEFAULT_BM;
+
+  if (K == 0)
+    return;
+
+  GemmConfig g{r1, w, K, cfg.lda, cfg.ldb, cfg.ldb};
+
+  for (index_t ii = r0; ii < r1; ii += BM)
+    detail::compute_block(ws, A_op, X, C, g, ii, 0, std::min(BM, r1 - ii), w,
+                          epilogue::Identity{}, true);
+}
+
+// ================================================================
+// Columns of B are independent right-hand sides: each thread runs the
+// whole blocked algorithm on its own column strip, no barriers between
+// diagonal blocks.
+// ================================================================
+template <class StripFn>
+static void for_each_strip(const TriangularConfig &cfg, const StripFn &fn) {
+  constexpr index_t BN = config::DEFAULT_BN;
+  constexpr index_t NR = config::NR;
+
+  if (cfg.M == 0 || cfg.N == 0)
+    return;
+
+  unsigned num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0)
+    num_threads = 4;
+
+  // Up to BN columns per strip, narrower when that leaves cores idle
+  index_t w = (cfg.N + num_threads - 1) / num_threads;
+  w = std::clamp((w + NR - 1) / NR * NR, NR, BN);
+
+  index_t strips = (cfg.N + w - 1) / w;
+
+  detail::parallel_tiles(strips, [&](Workspace &ws, index_t s) {
+    index_t j0 = s * w;
+    fn(ws, j0, std::min(w, cfg.N - j0));
+  });
+}
+
+// ================================================================
+// Public API
+// ================================================================
+void gemm_trsm(const float *A, float *B, const TriangularConfig &cfg) {
+  const index_t M = cfg.M;
+  const index_t blocks = (M + TRIANGLE_NB - 1) / TRIANGLE_NB;
+  const bool lower = cfg.uplo == Triangle::Lower;
+
+  for_each_strip(cfg, [&](Workspace &ws, index_t j0, index_t w) {
+    float *Bs = B + j0;
+
+    // Lower: top-down, update the rows below. Upper: bottom-up, above.
+    for (index_t s = 0; s < blocks; ++s) {
+      index_t k = (lower ? s : blocks - 1 - s) * TRIANGLE_NB;
+      index_t nb = std::min(TRIANGLE_NB, M - k);
+
+      diag_solve(A + k * cfg.lda + k, cfg.lda, Bs + k * cfg.ldb, cfg.ldb, nb,
+                 w, cfg);
+
+      detail::ScaledOperand neg{A + k, -1.0f};
+      if (lower)
+        block_update(ws, &neg, Bs + k * cfg.ldb, Bs, cfg, k + nb, M, nb, w);
+      else
+        block_update(ws, &neg, Bs + k * cfg.ldb, Bs, cfg, 0, k, nb, w);
+    }
+  });
+}
+
+void gemm_trmm(const float *A, float *B, const TriangularConfig &cfg) {
+  const index_t M = cfg.M;
+  const index_t blocks = (M + TRIANGLE_NB - 1) / TRIANGLE_NB;
+  const bool lower = cfg.uplo == Triangle::Lower;
+
+  for_each_strip(cfg, [&](Workspace &ws, index_t j0, index_t w) {
+    float *Bs = B + j0;
+
+    // Each block row only reads rows not yet overwritten:
+    // lower bottom-up (rows above), upper top-down (rows below)
+    for (index_t s = 0; s < blocks; ++s) {
+      index_t k = (lower ? blocks - 1 - s : s) * TRIANGLE_NB;
+      index_t nb = std::min(TRIANGLE_NB, M - k);
+
+      diag_multiply(A + k * cfg.lda + k, cfg.lda, Bs + k * cfg.ldb, cfg.ldb,
+                    nb, w, cfg);
+
+      if (lower)
+        block_update(ws, A, Bs, Bs, cfg, k, k + nb, k, w);
+      else
+        block_update(ws, A + k + nb, Bs + (k + nb) * cfg.ldb, Bs, cfg, k,
+                     k + nb, M - k - nb, w);
+    }
+  });
+}
+
+} // namespace gemm
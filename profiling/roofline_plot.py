@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Roofline plot of a benchmark_roofline JSON file.
+
+    ./benchmark_roofline --json roofline.json
+    python3 profiling/roofline_plot.py roofline.json -o roofline.png
+
+One roof per measured thread count: the FMA peak and one bandwidth slope
+per memory level (L1, L2, SLC/L3, DRAM). Kernels are drawn at their
+compulsory arithmetic intensity against the roof of the thread count they
+were placed on.
+"""
+
+import argparse
+import json
+import sys
+from collections import defaultdict
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)["results"]
+
+    peaks = defaultdict(float)  # threads -> GFLOP/s
+    bandwidth = defaultdict(dict)  # threads -> level -> GB/s
+    kernels = []
+
+    for r in results:
+        threads = int(r["threads"])
+        if r["kind"] == "peak":
+            peaks[threads] = max(peaks[threads], float(r["gflops"]))
+        elif r["kind"] == "bandwidth":
+            level = r["scenario"].replace("bandwidth_", "")
+            bw = float(r["bandwidth_gbs"])
+            bandwidth[threads][level] = max(bandwidth[threads].get(level, 0.0), bw)
+        elif r["kind"] == "kernel":
+            kernels.append(r)
+
+    return peaks, bandwidth, kernels
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("json", help="benchmark_roofline --json output")
+    ap.add_argument("-o", "--output", default="roofline.png")
+    ap.add_argument("--threads", type=int, help="only this roof")
+    args = ap.parse_args()
+
+    peaks, bandwidth, kernels = load(args.json)
+    if not peaks:
+        sys.exit("no peak records in " + args.json)
+
+    try:
+        import matplotlib
+
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        sys.exit("matplotlib is required (pip install matplotlib)")
+
+    fig, ax = plt.subplots(figsize=(9, 6))
+    ai = [2.0 ** e for e in range(-4, 11)]
+    styles = ["-", "--", ":", "-."]
+
+    for t in sorted(peaks):
+        if args.threads and t != args.threads:
+            continue
+        peak = peaks[t]
+        for (level, bw), style in zip(bandwidth[t].items(), styles):
+            ax.plot(ai, [min(peak, x * bw) for x in ai], style,
+                    label=f"{t} thr: {level} {bw:.0f} GB/s")
+        ax.axhline(peak, color="gray", linewidth=0.5)
+        ax.text(ai[-1], peak, f"{peak:.0f} GFLOP/s ({t} thr)",
+                ha="right", va="bottom", fontsize=8)
+
+    for k in kernels:
+        if args.threads and int(k["threads"]) != args.threads:
+            continue
+        x, y = float(k["ai"]), float(k["gflops"])
+        ax.plot(x, y, "o")
+        ax.annotate(f'{k["kernel"]} {k["M"]}x{k["N"]}x{k["K"]}', (x, y),
+                    fontsize=7, xytext=(3, 3), textcoords="offset points")
+
+    ax.set_xscale("log", base=2)
+    ax.set_yscale("log", base=2)
+    ax.set_xlabel("arithmetic intensity (FLOP / byte)")
+    ax.set_ylabel("GFLOP/s")
+    ax.set_title("Roofline")
+    ax.grid(True, which="both", linewidth=0.3)
+    ax.legend(fontsize=7, loc="lower right")
+    fig.tight_layout()
+    fig.savefig(args.output, dpi=150)
+    print("wrote", args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../gemm/kernels.hpp"
+
+using namespace gemm;
+
+static void fill_random(std::vector<double> &x) {
+  static std::mt19937 rng(42);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (double &v : x)
+    v = dist(rng);
+}
+
+int main() {
+  // Well below anything an fp32 path could reach at these K
+  constexpr double eps = 1e-12;
+
+  struct Shape {
+    size_t M, N, K;
+  };
+  std::vector<Shape> shapes = {{8, 4, 1},      {8, 8, 8},     {37, 29, 45},
+                               {256, 256, 256}, {300, 129, 513}, {1, 300, 77}};
+
+  std::cout << "\n=== DGEMM (fp64 v5 / v6) Correctness Check ===\n";
+  std::cout << std::setw(6) << "M" << std::setw(6) << "N" << std::setw(6)
+            << "K" << std::setw(16) << "v5 rel err" << std::setw(16)
+            << "v6 rel err"
+            << "\n";
+  std::cout << std::string(50, '-') << "\n";
+
+  for (const Shape &s : shapes) {
+    const size_t lda = s.K + 1, ldb = s.N + 3, ldc = s.N + 2;
+    GemmConfig cfg{s.M, s.N, s.K, lda, ldb, ldc};
+
+    std::vector<double> A(s.M * lda), B(s.K * ldb), C0(s.M * ldc);
+    fill_random(A);
+    fill_random(B);
+    fill_random(C0);
+
+    // Reference: C += A * B in long double
+    std::vector<double> ref(s.M * s.N);
+    for (size_t i = 0; i < s.M; ++i)
+      for (size_t j = 0; j < s.N; ++j) {
+        long double sum = C0[i * ldc + j];
+        for (size_t k = 0; k < s.K; ++k)
+          sum += (long double)A[i * lda + k] * B[k * ldb + j];
+        ref[i * s.N + j] = double(sum);
+      }
+
+    auto rel_err = [&](const std::vector<double> &C) {
+      double err = 0.0;
+      for (size_t i = 0; i < s.M; ++i)
+        for (size_t j = 0; j < s.N; ++j) {
+          double r = ref[i * s.N + j];
+          err = std::max(err, std::abs(C[i * ldc + j] - r) /
+                                  std::max(1.0, std::abs(r)));
+        }
+      return err;
+    };
+
+    std::vector<double> C5 = C0, C6 = C0;
+    gemm_v5_packed_neon(A.data(), B.data(), C5.data(), cfg);
+    gemm_v6_parallel(A.data(), B.data(), C6.data(), cfg);
+
+    double e5 = rel_err(C5), e6 = rel_err(C6);
+
+    std::cout << std::setw(6) << s.M << std::setw(6) << s.N << std::setw(6)
+              << s.K << std::setw(16) << e5 << std::setw(16) << e6 << "\n";
+
+    if (e5 > eps || e6 > eps) {
+      std::cerr << "\n❌ DGEMM FAILED at M=" << s.M << " N=" << s.N
+                << " K=" << s.K << "\n";
+      return 1;
+    }
+  }
+
+  std::cout << "\n✅ DGEMM passed all correctness checks.\n";
+  return 0;
+}
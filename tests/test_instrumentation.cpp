@@ -0,0 +1,104 @@
+#include "../gemm/instrument.hpp"
+#include "../gemm/kernels.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace gemm;
+
+// Instrumented builds (-DATLAS_INSTRUMENT) fill per-call records; other
+// builds must leave every query empty
+int main() {
+  std::cout << "\n=== TEST: Per-Phase Instrumentation ===\n";
+
+  // 5 x 4 blocks of 64 x 64 with ragged edges (edge tiles present)
+  const size_t M = 300, N = 250, K = 200;
+  const BlockSizes bs{64, 64, 64};
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> A(M * K), B(K * N), C(M * N, 0.0f);
+  for (float &v : A)
+    v = dist(rng);
+  for (float &v : B)
+    v = dist(rng);
+
+  const GemmConfig cfg{M, N, K, K, N, N};
+
+  size_t callbacks = 0;
+  instrument::set_callback([&](const instrument::CallStats &) { ++callbacks; });
+  instrument::reset_totals();
+
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {3, nullptr});
+  const instrument::CallStats v6 = instrument::last_call();
+
+  gemm_v5_packed_neon(A.data(), B.data(), C.data(), cfg, bs);
+  const instrument::CallStats v5 = instrument::last_call();
+
+  const instrument::Totals t = instrument::totals();
+  instrument::set_callback(nullptr);
+
+  bool ok = true;
+
+#ifdef ATLAS_INSTRUMENT
+  const size_t blocks = 5 * 4;
+  const double us = 1e6 / instrument::ticks_per_second();
+
+  std::cout << std::setw(8) << "worker" << std::setw(7) << "tiles";
+  for (size_t p = 0; p < instrument::NUM_PHASES; ++p)
+    std::cout << std::setw(13) << perf::phase_name(instrument::Phase(p));
+  std::cout << std::setw(10) << "busy" << std::setw(10) << "start"
+            << std::setw(10) << "idle" << "   (us)\n";
+
+  size_t tiles = 0;
+  for (size_t w = 0; w < v6.workers.size(); ++w) {
+    const instrument::WorkerStats &s = v6.workers[w];
+    std::cout << std::fixed << std::setprecision(1) << std::setw(8) << w
+              << std::setw(7) << s.tiles;
+    for (auto p : s.phase_ticks)
+      std::cout << std::setw(13) << double(p) * us;
+    std::cout << std::setw(10) << double(s.busy_ticks) * us << std::setw(10)
+              << double(s.start_ticks) * us << std::setw(10)
+              << double(s.idle_ticks) * us << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    // Phases nest inside tiles
+    uint64_t phases =
+        std::accumulate(s.phase_ticks.begin(), s.phase_ticks.end(), 0ull);
+    ok = ok && phases <= s.busy_ticks && s.busy_ticks <= v6.wall_ticks;
+    tiles += s.tiles;
+  }
+
+  std::cout << "imbalance " << v6.imbalance() << ", idle fraction "
+            << v6.idle_fraction() << "\n";
+
+  auto phase = [](const instrument::WorkerStats &s, instrument::Phase p) {
+    return s.phase_ticks[size_t(p)];
+  };
+
+  ok = ok && v6.workers.size() == 3 && tiles == blocks &&
+       v6.imbalance() >= 1.0 && v5.workers.size() == 1 &&
+       v5.workers[0].tiles == blocks &&
+       phase(v5.workers[0], instrument::Phase::Microkernel) > 0 &&
+       phase(v5.workers[0], instrument::Phase::Edge) > 0 &&
+       phase(v5.workers[0], instrument::Phase::PackA) > 0 &&
+       phase(v5.workers[0], instrument::Phase::PackB) > 0 &&
+       callbacks == 2 && t.calls == 2 && t.tiles == 2 * blocks &&
+       t.worker_slots == 4;
+#else
+  std::cout << "instrumentation compiled out\n";
+  ok = v6.workers.empty() && v5.workers.empty() && callbacks == 0 &&
+       t.calls == 0;
+#endif
+
+  if (!ok) {
+    std::cerr << "❌ Instrumentation test FAILED\n";
+    return 1;
+  }
+
+  std::cout << "✅ Instrumentation test passed all checks.\n";
+  return 0;
+}
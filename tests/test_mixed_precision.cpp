@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../atlas_memory/include/atlas_memory/half.hpp"
+#include "../atlas_memory/include/atlas_memory/packing.hpp"
+#include "../gemm/kernels.hpp"
+
+using namespace gemm;
+using namespace atlas_memory;
+
+static bool check_conversions() {
+  bool ok = true;
+  auto expect = [&](const char *what, std::uint32_t got, std::uint32_t want) {
+    if (got != want) {
+      std::cerr << "  " << what << ": got 0x" << std::hex << got << " want 0x"
+                << want << std::dec << "\n";
+      ok = false;
+    }
+  };
+
+  // bf16: round to nearest, ties to even
+  expect("bf16(1)", bf16_from_float(1.0f).bits, 0x3F80);
+  expect("bf16 tie->even", bf16_from_float(bits_float(0x3F808000u)).bits,
+         0x3F80);
+  expect("bf16 tie->odd up", bf16_from_float(bits_float(0x3F818000u)).bits,
+         0x3F82);
+  expect("bf16 above tie", bf16_from_float(bits_float(0x3F808001u)).bits,
+         0x3F81);
+  ok &= std::isnan(to_float(bf16_from_float(std::nanf(""))));
+
+  // fp16: range limits, subnormals, signed zero
+  expect("fp16(1)", fp16_from_float(1.0f).bits, 0x3C00);
+  expect("fp16(65504)", fp16_from_float(65504.0f).bits, 0x7BFF);
+  expect("fp16(65520)", fp16_from_float(65520.0f).bits, 0x7C00);
+  expect("fp16(2^-24)", fp16_from_float(std::ldexp(1.0f, -24)).bits, 0x0001);
+  expect("fp16(2^-25)", fp16_from_float(std::ldexp(1.0f, -25)).bits, 0x0000);
+  expect("fp16(3*2^-25)", fp16_from_float(std::ldexp(3.0f, -25)).bits,
+         0x0002);
+  expect("fp16(-0)", fp16_from_float(-0.0f).bits, 0x8000);
+
+  // Every non-NaN binary16 value survives a round trip
+  for (std::uint32_t b = 0; b < 0x10000; ++b) {
+    fp16_t h{std::uint16_t(b)};
+    if ((b & 0x7C00) == 0x7C00 && (b & 0x3FF))
+      continue;
+    if (fp16_from_float(to_float(h)).bits != b) {
+      expect("fp16 round trip", fp16_from_float(to_float(h)).bits, b);
+      break;
+    }
+  }
+
+  // Every bf16 value survives a round trip (NaNs stay NaN)
+  for (std::uint32_t b = 0; b < 0x10000; ++b) {
+    bf16_t h{std::uint16_t(b)};
+    float f = to_float(h);
+    if (std::isnan(f) ? !std::isnan(to_float(bf16_from_float(f)))
+                      : bf16_from_float(f).bits != b) {
+      expect("bf16 round trip", bf16_from_float(f).bits, b);
+      break;
+    }
+  }
+
+  return ok;
+}
+
+static bool check_packing() {
+  const int rows = 5, cols = 7, ld = 9;
+  std::vector<bf16_t> src(rows * ld);
+  for (int i = 0; i < rows * ld; ++i)
+    src[i] = bf16_from_float(float(i) * 0.25f - 3.0f);
+
+  std::vector<float> dstA(rows * cols), dstB(rows * cols);
+  pack_A(dstA.data(), src.data(), rows, cols, ld);
+  pack_B(dstB.data(), src.data(), rows, cols, ld);
+
+  for (int i = 0; i < rows; ++i)
+    for (int k = 0; k < cols; ++k)
+      if (dstA[i * cols + k] != to_float(src[i * ld + k]) ||
+          dstB[i * cols + k] != to_float(src[i * ld + k]))
+        return false;
+
+  return true;
+}
+
+template <class T> static T narrow(float v) {
+  T t;
+  convert(t, v);
+  return t;
+}
+
+// C += A * B against an fp32 reference built from the widened inputs
+template <class TA, class TB, class TC>
+static bool check_gemm(const std::string &name, size_t M, size_t N, size_t K,
+                       float tol) {
+  static std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  const size_t lda = K + 2, ldb = N + 3, ldc = N + 1;
+  std::vector<TA> A(M * lda);
+  std::vector<TB> B(K * ldb);
+  std::vector<TC> C(M * ldc);
+
+  for (auto &v : A)
+    v = narrow<TA>(dist(rng));
+  for (auto &v : B)
+    v = narrow<TB>(dist(rng));
+  for (auto &v : C)
+    v = narrow<TC>(dist(rng));
+
+  std::vector<float> ref(M * N);
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      float sum = to_float(C[i * ldc + j]);
+      for (size_t k = 0; k < K; ++k)
+        sum += to_float(A[i * lda + k]) * to_float(B[k * ldb + j]);
+      ref[i * N + j] = sum;
+    }
+
+  gemm_mixed(A.data(), B.data(), C.data(),
+             GemmConfig{M, N, K, lda, ldb, ldc});
+
+  // Relative to the magnitude of the result (16-bit C rounds once)
+  float err = 0.0f;
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      float r = ref[i * N + j];
+      err = std::max(err, std::abs(to_float(C[i * ldc + j]) - r) /
+                              std::max(1.0f, std::abs(r)));
+    }
+
+  std::cout << std::setw(26) << name << std::setw(6) << M << std::setw(6) << N
+            << std::setw(6) << K << std::setw(14) << err << "\n";
+  return err <= tol;
+}
+
+int main() {
+  std::cout << "\n=== TEST: Mixed Precision (bf16/fp16 storage) ===\n";
+
+  if (!check_conversions()) {
+    std::cerr << "\n❌ bf16/fp16 conversion FAILED\n";
+    return 1;
+  }
+  std::cout << "Conversions OK\n";
+
+  if (!check_packing()) {
+    std::cerr << "\n❌ Converting pack FAILED\n";
+    return 1;
+  }
+  std::cout << "Converting pack OK\n\n";
+
+  bool ok = true;
+  for (size_t n : {8, 37, 300}) {
+    ok &= check_gemm<float, bf16_t, float>("f32 x bf16 -> f32", n, n + 3,
+                                           n + 5, 1e-4f);
+    ok &= check_gemm<float, fp16_t, float>("f32 x fp16 -> f32", n, n + 3,
+                                           n + 5, 1e-4f);
+    ok &= check_gemm<bf16_t, bf16_t, float>("bf16 x bf16 -> f32", n, n, n,
+                                            1e-4f);
+    ok &= check_gemm<fp16_t, fp16_t, float>("fp16 x fp16 -> f32", n, n, n,
+                                            1e-4f);
+    ok &= check_gemm<bf16_t, bf16_t, bf16_t>("bf16 x bf16 -> bf16", n, n + 1,
+                                             n + 2, 1.0f / 128);
+    ok &= check_gemm<fp16_t, fp16_t, fp16_t>("fp16 x fp16 -> fp16", n, n + 1,
+                                             n + 2, 1.0f / 1024);
+  }
+
+  if (!ok) {
+    std::cerr << "\n❌ Mixed-precision GEMM FAILED\n";
+    return 1;
+  }
+
+  std::cout << "\n✅ Mixed precision passed all checks.\n";
+  return 0;
+}
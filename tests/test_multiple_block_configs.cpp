@@ -1,18 +1,84 @@
 #include "../atlas_memory/include/atlas_memory/workspace.hpp"
+#include "../gemm/kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <vector>
 
 using namespace atlas_memory;
 
+// v5 / v6 with runtime block sizes against a double reference (C += A * B)
+static bool check_drivers(const gemm::BlockSizes &bs) {
+  const size_t M = 150, N = 170, K = 300;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  std::vector<float> A(M * K), B(K * N), C5(M * N), C6(M * N);
+  for (float &v : A)
+    v = dist(rng);
+  for (float &v : B)
+    v = dist(rng);
+  for (float &v : C5)
+    v = dist(rng);
+  C6 = C5;
+
+  std::vector<double> ref(M * N);
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      double sum = C5[i * N + j];
+      for (size_t k = 0; k < K; ++k)
+        sum += double(A[i * K + k]) * B[k * N + j];
+      ref[i * N + j] = sum;
+    }
+
+  gemm::GemmConfig cfg{M, N, K, K, N, N};
+  gemm::gemm_v5_packed_neon(A.data(), B.data(), C5.data(), cfg, bs);
+  gemm::gemm_v6_parallel(A.data(), B.data(), C6.data(), cfg, bs);
+
+  double err = 0.0;
+  for (size_t i = 0; i < M * N; ++i)
+    err = std::max({err, std::abs(C5[i] - ref[i]), std::abs(C6[i] - ref[i])});
+
+  return err <= 1e-5 * std::sqrt(double(K));
+}
+
 int main() {
   std::cout << "\n=== TEST: Multiple Block Configurations ===\n";
 
-  const int configs[][3] = {
-      {64, 64, 64}, {128, 128, 64}, {256, 128, 128}, {192, 256, 128}};
+  const int configs[][3] = {{64, 64, 64},   {128, 128, 64}, {256, 128, 128},
+                            {192, 256, 128}, {100, 36, 50}};
 
   for (auto &c : configs) {
     Workspace ws(c[0], c[1], c[2], 8, 8);
+
+    bool ok = ws.block_m() == size_t(c[0]) && ws.block_n() == size_t(c[1]) &&
+              ws.block_k() == size_t(c[2]) &&
+              check_drivers({size_t(c[0]), size_t(c[1]), size_t(c[2])});
+
     std::cout << "Config BM=" << c[0] << " BN=" << c[1] << " BK=" << c[2]
-              << " OK\n";
+              << (ok ? " OK\n" : " FAILED\n");
+
+    if (!ok) {
+      std::cerr << "❌ Multiple configs FAILED\n";
+      return 1;
+    }
+  }
+
+  // Zero sizes are treated as 1 instead of never advancing
+  const gemm::BlockSizes zeros[] = {{0, 64, 0}, {64, 0, 64}};
+  for (const gemm::BlockSizes &bs : zeros) {
+    bool ok = check_drivers(bs);
+
+    std::cout << "Config BM=" << bs.BM << " BN=" << bs.BN << " BK=" << bs.BK
+              << (ok ? " OK\n" : " FAILED\n");
+
+    if (!ok) {
+      std::cerr << "❌ Multiple configs FAILED\n";
+      return 1;
+    }
   }
 
   std::cout << "Multiple configs PASSED\n";
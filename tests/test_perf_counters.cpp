@@ -0,0 +1,80 @@
+#include "../gemm/kernels.hpp"
+#include "../gemm/perf_counters.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace gemm;
+
+// Counters are optional on any host: the checks hold with every event,
+// with some of them, and with none (containers, perf_event_paranoid)
+int main() {
+  std::cout << "\n=== TEST: Hardware Performance Counters ===\n";
+
+  const size_t M = 256, N = 256, K = 256;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> A(M * K), B(K * N), C(M * N, 0.0f);
+  for (float &v : A)
+    v = dist(rng);
+  for (float &v : B)
+    v = dist(rng);
+
+  const GemmConfig cfg{M, N, K, K, N, N};
+
+  perf::reset_phase_counts();
+  perf::CounterSet set;
+  set.start();
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg);
+  perf::Counts c = set.stop();
+
+  std::cout << "counters " << (set.available() ? "available" : "unavailable")
+            << "\n";
+  std::cout << std::setw(16) << "event" << std::setw(8) << "valid"
+            << std::setw(16) << "value" << "\n";
+  for (size_t e = 0; e < perf::NUM_EVENTS; ++e)
+    std::cout << std::setw(16) << perf::event_name(perf::Event(e))
+              << std::setw(8) << (c.valid[e] ? "yes" : "no") << std::setw(16)
+              << c.value[e] << "\n";
+
+  bool ok = true;
+
+  // Unavailable events read as zero; derived metrics are NaN, not garbage
+  for (size_t e = 0; e < perf::NUM_EVENTS; ++e)
+    if (!c.valid[e] && c.value[e] != 0)
+      ok = false;
+  if (!set.available())
+    ok = ok && std::isnan(c.ipc()) && std::isnan(c.flops_per_cycle(1e6));
+
+  // A 33 MFLOP GEMM (worker threads inherited) takes >1M cycles
+  if (c.has(perf::Event::Cycles))
+    ok = ok && c[perf::Event::Cycles] > 1000000;
+  if (c.has(perf::Event::Instructions) && c.has(perf::Event::Cycles))
+    ok = ok && c.ipc() > 0.0;
+
+  // Phase totals: filled only in library mode, never invalid-but-nonzero
+  for (const perf::Counts &pc : perf::phase_counts())
+    for (size_t e = 0; e < perf::NUM_EVENTS; ++e)
+      if (!pc.valid[e] && pc.value[e] != 0)
+        ok = false;
+
+#ifdef ATLAS_PERF_COUNTERS
+  if (set.available()) {
+    const auto phases = perf::phase_counts();
+    ok = ok && phases[size_t(perf::Phase::Microkernel)][perf::Event::Cycles] >
+                   phases[size_t(perf::Phase::Edge)][perf::Event::Cycles];
+  }
+#endif
+
+  if (!ok) {
+    std::cerr << "❌ Perf counter test FAILED\n";
+    return 1;
+  }
+
+  std::cout << "✅ Perf counter test passed all checks.\n";
+  return 0;
+}
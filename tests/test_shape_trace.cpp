@@ -0,0 +1,84 @@
+#include "../gemm/kernels.hpp"
+#include "../gemm/shape_trace.hpp"
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace gemm;
+
+int main() {
+  std::cout << "\n=== TEST: Shape Trace Capture ===\n";
+
+  const char *path = "/tmp/atlas_test_shape_trace.bin";
+
+  // Odd shape with padded leading dimensions
+  const size_t M = 37, N = 53, K = 71, lda = 80, ldb = 64, ldc = 60;
+  std::vector<float> A(M * lda, 0.5f), B(K * ldb, 0.25f), C(M * ldc, 0.0f);
+  std::vector<double> Ad(M * lda, 0.5), Bd(K * ldb, 0.25), Cd(M * ldc, 0.0);
+  const GemmConfig cfg{M, N, K, lda, ldb, ldc};
+
+  // Not recording yet
+  gemm_v5_packed_neon(A.data(), B.data(), C.data(), cfg);
+
+  bool ok = shape_trace::start(path);
+
+  gemm_v5_packed_neon(A.data(), B.data(), C.data(), cfg);
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, {}, {3, nullptr});
+  gemm_v6_parallel(Ad.data(), Bd.data(), Cd.data(), cfg);
+  gemm_dispatch(A.data(), B.data(), C.data(), cfg); // routes to v6: one record
+
+  // One Strassen level (crossover 16) plus v6 peels: one record
+  gemm_strassen(A.data(), B.data(), C.data(), cfg, 16);
+
+  shape_trace::stop();
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg);
+
+  std::vector<shape_trace::Record> trace;
+  ok = ok && shape_trace::read(path, trace);
+
+  std::cout << std::setw(10) << "entry" << std::setw(6) << "type"
+            << std::setw(6) << "M" << std::setw(6) << "N" << std::setw(6)
+            << "K" << std::setw(6) << "lda" << std::setw(6) << "ldb"
+            << std::setw(6) << "ldc" << std::setw(9) << "threads"
+            << std::setw(12) << "time_ns" << "\n";
+  for (const shape_trace::Record &r : trace)
+    std::cout << std::setw(10) << shape_trace::entry_name(r.entry)
+              << std::setw(6)
+              << (r.dtype == shape_trace::DType::F64 ? "f64" : "f32")
+              << std::setw(6) << r.M << std::setw(6) << r.N << std::setw(6)
+              << r.K << std::setw(6) << r.lda << std::setw(6) << r.ldb
+              << std::setw(6) << r.ldc << std::setw(9) << r.threads
+              << std::setw(12) << r.time_ns << "\n";
+
+  const shape_trace::Entry expected[] = {
+      shape_trace::Entry::V5, shape_trace::Entry::V6, shape_trace::Entry::V6,
+      shape_trace::Entry::Dispatch, shape_trace::Entry::Strassen};
+
+  ok = ok && trace.size() == 5;
+  for (size_t i = 0; ok && i < trace.size(); ++i) {
+    const shape_trace::Record &r = trace[i];
+    ok = r.entry == expected[i] && r.M == M && r.N == N && r.K == K &&
+         r.lda == lda && r.ldb == ldb && r.ldc == ldc && r.time_ns > 0 &&
+         r.dtype == (i == 2 ? shape_trace::DType::F64
+                            : shape_trace::DType::F32);
+  }
+  ok = ok && trace[0].threads == 1 && trace[1].threads == 3;
+
+  // Not a trace
+  std::FILE *f = std::fopen(path, "wb");
+  std::fputs("not a trace file", f);
+  std::fclose(f);
+  ok = ok && !shape_trace::read(path, trace) &&
+       !shape_trace::read("/nonexistent/trace.bin", trace);
+  std::remove(path);
+
+  if (!ok) {
+    std::cerr << "❌ Shape trace test FAILED\n";
+    return 1;
+  }
+
+  std::cout << "✅ Shape trace test passed all checks.\n";
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../gemm/kernels.hpp"
+
+using namespace gemm;
+
+static void fill_random(std::vector<float> &x) {
+  static std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (float &v : x)
+    v = dist(rng);
+}
+
+// C += A * B against double; the error must respect the reported bound
+static bool check_case(size_t M, size_t N, size_t K, size_t crossover,
+                       int want_levels) {
+  const size_t lda = K + 1, ldb = N + 3, ldc = N + 2;
+  GemmConfig cfg{M, N, K, lda, ldb, ldc};
+
+  std::vector<float> A(M * lda), B(K * ldb), C(M * ldc);
+  fill_random(A);
+  fill_random(B);
+  fill_random(C);
+
+  std::vector<double> ref(M * N);
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      double sum = C[i * ldc + j];
+      for (size_t k = 0; k < K; ++k)
+        sum += double(A[i * lda + k]) * B[k * ldb + j];
+      ref[i * N + j] = sum;
+    }
+
+  StrassenReport plan = strassen_plan(cfg, crossover);
+  StrassenReport rep = gemm_strassen(A.data(), B.data(), C.data(), cfg,
+                                     crossover);
+
+  double err = 0.0;
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j)
+      err = std::max(err, std::abs(C[i * ldc + j] - ref[i * N + j]));
+
+  // max|A|, max|B| <= 1; the bound covers A * B, C adds one rounding
+  const double u = std::numeric_limits<float>::epsilon() / 2;
+  double bound = rep.error_factor * u + 1e-6;
+
+  std::cout << std::setw(6) << M << std::setw(6) << N << std::setw(6) << K
+            << std::setw(7) << rep.levels << std::setw(10) << rep.products
+            << std::setw(10) << rep.flop_ratio << std::setw(14) << err
+            << std::setw(14) << bound << "\n";
+
+  return rep.levels == want_levels && plan.levels == rep.levels &&
+         err <= bound && rep.error_factor >= rep.conventional_factor;
+}
+
+int main() {
+  std::cout << "\n=== TEST: Strassen (fused-packing) GEMM ===\n";
+  std::cout << std::setw(6) << "M" << std::setw(6) << "N" << std::setw(6)
+            << "K" << std::setw(7) << "levels" << std::setw(10) << "products"
+            << std::setw(10) << "flops" << std::setw(14) << "max err"
+            << std::setw(14) << "bound"
+            << "\n";
+  std::cout << std::string(73, '-') << "\n";
+
+  bool ok = true;
+
+  // Below the crossover: conventional
+  ok &= check_case(100, 100, 100, 64, 0);
+  // One and two levels, even and odd (peeled) dimensions
+  ok &= check_case(256, 256, 256, 64, 2);
+  ok &= check_case(257, 263, 301, 128, 1);
+  ok &= check_case(300, 270, 290, 64, 2);
+  // Level cap
+  ok &= check_case(512, 512, 512, 16, 2);
+
+  // The default crossover keeps typical sizes conventional
+  ok &= strassen_plan({2047, 4096, 4096, 4096, 4096, 4096}).levels == 0;
+  ok &= strassen_plan({4096, 4096, 4096, 4096, 4096, 4096}).levels == 2;
+
+  if (!ok) {
+    std::cerr << "\n❌ Strassen GEMM FAILED\n";
+    return 1;
+  }
+
+  std::cout << "\n✅ Strassen GEMM passed all checks.\n";
+  return 0;
+}
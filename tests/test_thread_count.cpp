@@ -0,0 +1,92 @@
+#include "../gemm/kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace gemm;
+
+static void fill_random(std::vector<float> &x) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (float &v : x)
+    v = dist(rng);
+}
+
+int main() {
+  std::cout << "\n=== TEST: v6 Thread Count and Worker Stats ===\n";
+
+  // 5 x 4 tiles of 64 x 64: more tiles than workers, plus ragged edges
+  const size_t M = 300, N = 250, K = 200;
+  const BlockSizes bs{64, 64, 64};
+
+  std::vector<float> A(M * K), B(K * N), C0(M * N);
+  fill_random(A);
+  fill_random(B);
+  fill_random(C0);
+
+  std::vector<double> ref(M * N);
+  for (size_t i = 0; i < M; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      double sum = C0[i * N + j];
+      for (size_t k = 0; k < K; ++k)
+        sum += double(A[i * K + k]) * B[k * N + j];
+      ref[i * N + j] = sum;
+    }
+
+  const GemmConfig cfg{M, N, K, K, N, N};
+  const size_t total_tiles = 5 * 4;
+
+  std::cout << std::setw(8) << "threads" << std::setw(9) << "workers"
+            << std::setw(8) << "tiles" << std::setw(14) << "max_error"
+            << "\n";
+
+  for (unsigned threads : {1u, 2u, 3u, 7u, 64u}) {
+    std::vector<float> C = C0;
+    ThreadStats st;
+    gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {threads, &st});
+
+    double err = 0.0;
+    for (size_t i = 0; i < M * N; ++i)
+      err = std::max(err, std::abs(C[i] - ref[i]));
+    err /= std::sqrt(double(K));
+
+    // Workers are capped at the tile count; every tile is counted once
+    size_t workers = std::min<size_t>(threads, total_tiles);
+    size_t tiles = std::accumulate(st.tiles.begin(), st.tiles.end(), size_t(0));
+    double busy = std::accumulate(st.busy.begin(), st.busy.end(), 0.0);
+
+    std::cout << std::setw(8) << threads << std::setw(9) << st.busy.size()
+              << std::setw(8) << tiles << std::setw(14) << std::scientific
+              << std::setprecision(3) << err << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    bool ok = err <= 1e-5 && st.busy.size() == workers &&
+              st.tiles.size() == workers && tiles == total_tiles &&
+              st.wall > 0.0 && busy > 0.0 &&
+              busy <= double(workers) * st.wall * 1.01;
+
+    if (!ok) {
+      std::cerr << "❌ Thread count test FAILED (threads=" << threads << ")\n";
+      return 1;
+    }
+  }
+
+  // An empty problem reports zero workers, even through a reused stats
+  ThreadStats st;
+  std::vector<float> C = C0;
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {3, &st});
+  gemm_v6_parallel(A.data(), B.data(), C.data(), GemmConfig{0, N, K, K, N, N},
+                   bs, {3, &st});
+  if (!st.busy.empty() || !st.tiles.empty() || st.wall != 0.0) {
+    std::cerr << "❌ Thread count test FAILED (stale stats on M = 0)\n";
+    return 1;
+  }
+
+  std::cout << "✅ Thread count test passed all checks.\n";
+  return 0;
+}
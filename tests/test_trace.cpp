@@ -0,0 +1,88 @@
+#include "../gemm/kernels.hpp"
+#include "../gemm/trace.hpp"
+
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gemm;
+
+static size_t count_events(const std::string &json, const char *name) {
+  const std::string key = std::string("\"name\": \"") + name + "\"";
+  size_t n = 0;
+  for (size_t pos = json.find(key); pos != std::string::npos;
+       pos = json.find(key, pos + 1))
+    ++n;
+  return n;
+}
+
+// Traced builds (-DATLAS_TRACE) record one span per call / setup / tile /
+// phase; other builds record nothing and dump an empty trace
+int main() {
+  std::cout << "\n=== TEST: Chrome Trace Export ===\n";
+
+  // 5 x 4 blocks of 64 x 64, K in 4 slices of 64
+  const size_t M = 300, N = 250, K = 200;
+  const BlockSizes bs{64, 64, 64};
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> A(M * K), B(K * N), C(M * N, 0.0f);
+  for (float &v : A)
+    v = dist(rng);
+  for (float &v : B)
+    v = dist(rng);
+
+  const GemmConfig cfg{M, N, K, K, N, N};
+
+  trace::start();
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {3, nullptr});
+  trace::stop();
+
+  // Stopped: not recorded
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {3, nullptr});
+
+  std::ostringstream os;
+  trace::write_chrome_json(os);
+  const std::string json = os.str();
+
+  const size_t calls = count_events(json, "gemm");
+  const size_t setups = count_events(json, "setup");
+  const size_t tiles = count_events(json, "tile");
+  const size_t packs = count_events(json, "pack_a");
+
+  std::cout << "events " << trace::recorded() << " (gemm " << calls
+            << ", setup " << setups << ", tile " << tiles << ", pack_a "
+            << packs << "), dropped " << trace::dropped() << "\n";
+
+  bool ok = json.find("\"traceEvents\": [") != std::string::npos &&
+            json.find("]}") != std::string::npos;
+
+#ifdef ATLAS_TRACE
+  // 20 blocks x 4 K slices of packing
+  ok = ok && calls == 1 && setups == 3 && tiles == 20 && packs == 80 &&
+       trace::dropped() == 0 &&
+       count_events(json, "microkernel") > 0 && count_events(json, "edge") > 0;
+
+  // Small rings keep only the newest events of each thread
+  trace::start(16);
+  gemm_v6_parallel(A.data(), B.data(), C.data(), cfg, bs, {3, nullptr});
+  trace::stop();
+
+  std::cout << "16-event rings: events " << trace::recorded() << ", dropped "
+            << trace::dropped() << "\n";
+  ok = ok && trace::dropped() > 0 && trace::recorded() <= 16 * 4;
+#else
+  ok = ok && trace::recorded() == 0 && calls == 0 && tiles == 0;
+#endif
+
+  if (!ok) {
+    std::cerr << "❌ Trace test FAILED\n";
+    return 1;
+  }
+
+  std::cout << "✅ Trace test passed all checks.\n";
+  return 0;
+}